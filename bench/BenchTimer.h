@@ -0,0 +1,23 @@
+#pragma once
+#include <chrono>
+#include <cstddef>
+#include <cstdlib>
+
+// Время одной итерации f() в наносекундах
+template <class F>
+double NsPerIteration(size_t iterations, F f)
+{
+  auto begin = std::chrono::steady_clock::now();
+  for (size_t i = 0; i < iterations; ++i)
+    f();
+  auto end = std::chrono::steady_clock::now();
+  return std::chrono::duration<double, std::nano>(end - begin).count() / iterations;
+}
+
+// Число итераций из первого аргумента командной строки
+inline size_t Iterations(int argc, char** argv, size_t byDefault)
+{
+  if (argc > 1)
+    return strtoull(argv[1], nullptr, 10);
+  return byDefault;
+}
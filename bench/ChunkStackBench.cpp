@@ -0,0 +1,35 @@
+#include <chrono>
+#include <iostream>
+#include "BenchTimer.h"
+#include "StackClass.h"
+#include "ChunkStackClass.h"
+
+// Глубокий стек: средняя и худшая задержка push у TStack (рост с копированием)
+// и TChunkStack (рост подключением блока)
+template <class TStackType>
+void Run(const char* name, size_t count)
+{
+  TStackType stack;
+  double worst = 0;
+  auto begin = std::chrono::steady_clock::now();
+  auto previous = begin;
+  for (size_t i = 0; i < count; ++i)
+  {
+    stack.push((int)i);
+    auto now = std::chrono::steady_clock::now();
+    worst = max(worst, std::chrono::duration<double, std::nano>(now - previous).count());
+    previous = now;
+  }
+  double average = std::chrono::duration<double, std::nano>(previous - begin).count() / count;
+  volatile int sink = 0;
+  double pop = NsPerIteration(count, [&] { sink = stack.pop(); });
+  cout << name << ": push avg " << average << " ns, push worst " << worst / 1e6 << " ms, pop " << pop << " ns\n";
+}
+
+int main(int argc, char** argv)
+{
+  size_t count = Iterations(argc, argv, 1 << 24);
+  Run<TStack<int>>("TStack", count);
+  Run<TChunkStack<int>>("TChunkStack", count);
+  return 0;
+}
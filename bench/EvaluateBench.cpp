@@ -0,0 +1,39 @@
+#include <iostream>
+#include <string>
+#include <vector>
+#include "BenchTimer.h"
+#include "FormulaClass.h"
+
+// Однократное вычисление: Evaluate против FormulaChecker + FormulaConverter + FormulaCalculator
+static void Compare(const string& expr, size_t n)
+{
+  volatile double sink = 0;
+  vector<int> brackets(expr.size() * 2 + 2);
+
+  double passes = NsPerIteration(n, [&] {
+    TFormula<double> formula(expr);
+    formula.FormulaChecker(brackets.data(), (int)brackets.size());
+    formula.FormulaConverter();
+    sink = formula.FormulaCalculator();
+  });
+  double fused = NsPerIteration(n, [&] { sink = TFormula<double>::Evaluate(expr); });
+
+  cout << expr.size() << " chars\n";
+  cout << "  three passes: " << passes << " ns\n";
+  cout << "  Evaluate:     " << fused << " ns\n";
+  cout << "  speedup: " << passes / fused << "x\n";
+}
+
+int main(int argc, char** argv)
+{
+  size_t n = Iterations(argc, argv, 100000);
+
+  Compare("1+2*3", n);
+  Compare("(1.5+2.25)*3-4/8+(7*2.5-1)*(3+4.75)/2", n);
+
+  string longExpr = "1";
+  for (int i = 0; i < 2000; ++i)
+    longExpr += (i % 3) ? "+2.5*3" : "-(4-1.25)";
+  Compare(longExpr, n / 1000 + 1);
+  return 0;
+}
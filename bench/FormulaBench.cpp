@@ -0,0 +1,77 @@
+#include <iostream>
+#include <cstring>
+#include <vector>
+#include <string>
+#include "BenchTimer.h"
+#include "FormulaClass.h"
+
+// Сравнение вычисления по тексту постфиксной формы и по скомпилированной программе
+int main(int argc, char** argv)
+{
+  size_t n = Iterations(argc, argv, 200000);
+  char expr[] = "(1.5+2.25)*3-4/8+(7*2.5-1)*(3+4.75)/2";
+  TFormula<double> formula(expr);
+  formula.FormulaConverter();
+
+  volatile double sink = 0;
+  double text = NsPerIteration(n, [&] { sink = formula.PostfixCalculator(); });
+  double program = NsPerIteration(n, [&] { sink = formula.FormulaCalculator(); });
+
+  cout << "expression: " << expr << "\n";
+  cout << "istringstream postfix: " << text << " ns/eval\n";
+  cout << "compiled program:      " << program << " ns/eval\n";
+  cout << "speedup: " << text / program << "x\n";
+
+  // Одна формула над столбцами значений
+  char batchExpr[] = "($0+2.5)*$1-$0/($1+1)";
+  TFormula<double> batch(batchExpr);
+  batch.FormulaConverter();
+  const size_t rows = 1 << 16;
+  vector<double> x(rows), y(rows), out(rows);
+  for (size_t i = 0; i < rows; ++i)
+  {
+    x[i] = i * 0.25;
+    y[i] = 1.0 + i % 13;
+  }
+  const double* columns[] = {x.data(), y.data()};
+  size_t passes = n / 1000 + 1;
+  double scalar = NsPerIteration(passes, [&] {
+    for (size_t i = 0; i < rows; ++i)
+    {
+      double values[] = {x[i], y[i]};
+      out[i] = batch.FormulaCalculator(values);
+    }
+  }) / rows;
+  double columnar = NsPerIteration(passes, [&] { batch.EvaluateBatch(columns, out); }) / rows;
+
+  cout << "\nexpression: " << batchExpr << ", " << rows << " rows\n";
+  cout << "scalar per row: " << scalar << " ns/row\n";
+  cout << "EvaluateBatch:  " << columnar << " ns/row\n";
+  cout << "speedup: " << scalar / columnar << "x\n";
+
+  // Разбор числовых констант
+  const char* token = "12345.6789";
+  size_t length = strlen(token);
+  double stream = NsPerIteration(n, [&] {
+    double num;
+    istringstream(string(token, length)) >> num;
+    sink = num;
+  });
+  double chars = NsPerIteration(n, [&] { sink = ParseNumber<double>(token, token + length); });
+  cout << "\nnumber token: " << token << "\n";
+  cout << "istringstream: " << stream << " ns/token\n";
+  cout << "ParseNumber:   " << chars << " ns/token\n";
+
+  // Время преобразования должно расти линейно с длиной выражения
+  cout << "\nFormulaConverter on long expressions:\n";
+  for (size_t terms = 1000; terms <= 1000000; terms *= 10)
+  {
+    string text = "1.5";
+    for (size_t i = 1; i < terms; ++i)
+      text += (i % 2) ? "*x+" : "-1.5";
+    TFormula<double> big(text);
+    double ns = NsPerIteration(1, [&] { big.FormulaConverter(); });
+    cout << text.size() << " chars: " << ns / text.size() << " ns/char\n";
+  }
+  return 0;
+}
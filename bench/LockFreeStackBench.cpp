@@ -0,0 +1,60 @@
+#include <iostream>
+#include <algorithm>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "BenchTimer.h"
+#include "StackClass.h"
+#include "LockFreeStackClass.h"
+
+// Пропускная способность пар push/pop из threads потоков (общий пул задач)
+template <class PushPop>
+static double Throughput(size_t threads, size_t perThread, PushPop pushPop)
+{
+  double ns = NsPerIteration(1, [&] {
+    vector<thread> pool;
+    for (size_t t = 0; t < threads; ++t)
+      pool.emplace_back([&, t] {
+        for (size_t i = 0; i < perThread; ++i)
+          pushPop(t * perThread + i);
+      });
+    for (thread& th : pool)
+      th.join();
+  });
+  return threads * perThread / ns * 1e9;
+}
+
+int main(int argc, char** argv)
+{
+  size_t n = Iterations(argc, argv, 1000000);
+  size_t cores = max(1u, thread::hardware_concurrency());
+
+  cout << "threads, Mpairs/s: TLockFreeStack vs TStack + mutex\n";
+  for (size_t threads = 1; threads <= 2 * cores; threads *= 2)
+  {
+    size_t perThread = n / threads;
+    TLockFreeStack<size_t> lockFree(1024);
+    volatile size_t sink = 0;
+    double unlocked = Throughput(threads, perThread, [&](size_t v) {
+      lockFree.try_push(v);
+      size_t out;
+      if (lockFree.try_pop(out))
+        sink = out;
+    });
+
+    TStack<size_t> stack(1024);
+    mutex lock;
+    double locked = Throughput(threads, perThread, [&](size_t v) {
+      {
+        lock_guard<mutex> guard(lock);
+        stack.push(v);
+      }
+      lock_guard<mutex> guard(lock);
+      if (!stack.IsEmpty())
+        sink = stack.pop();
+    });
+
+    cout << threads << ": " << unlocked / 1e6 << " vs " << locked / 1e6 << "\n";
+  }
+  return 0;
+}
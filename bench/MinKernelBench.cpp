@@ -0,0 +1,51 @@
+#include <iostream>
+#include <vector>
+#include "BenchTimer.h"
+#include "MinKernel.h"
+#include "StackClass.h"
+#include "QueueClass.h"
+
+// Минимум большого массива на каждом уровне ядра и через TStack/TQueue::Min
+template <class T>
+void Run(const char* name, size_t count, size_t repeats)
+{
+  std::vector<T> data(count);
+  unsigned seed = 7;
+  for (T& x : data)
+  {
+    seed = seed * 1103515245 + 12345;
+    x = T((int)(seed >> 8) % 1000000);
+  }
+  volatile T sink = T();
+  const char* levels[] = {"scalar", "sse", "avx2"};
+  for (TMinKernelLevel level : {MinScalar, MinSse, MinAvx2})
+  {
+    if (level > MinKernelLevel())
+      break;
+    double ns = NsPerIteration(repeats, [&] { sink = MinKernel(data[0], data.data() + 1, count - 1, level); });
+    cout << name << " " << levels[level] << ": " << ns / count << " ns/element\n";
+  }
+
+  TStack<T> stack(count);
+  TQueue<T> queue(count + 1);
+  for (size_t i = 0; i < count; ++i)
+  {
+    stack.push(data[i]);
+    queue.push(data[i]);
+  }
+  // Сдвигаем кольцо, чтобы очередь состояла из двух отрезков
+  for (size_t i = 0; i < count / 2; ++i)
+    queue.push(queue.pop());
+  double stackNs = NsPerIteration(repeats, [&] { sink = stack.Min(); });
+  double queueNs = NsPerIteration(repeats, [&] { sink = queue.Min(); });
+  cout << name << " TStack::Min: " << stackNs / count << " ns/element, TQueue::Min: " << queueNs / count << " ns/element\n";
+}
+
+int main(int argc, char** argv)
+{
+  size_t count = Iterations(argc, argv, 1 << 20);
+  Run<int>("int", count, 200);
+  Run<float>("float", count, 200);
+  Run<double>("double", count, 200);
+  return 0;
+}
@@ -0,0 +1,45 @@
+#include <iostream>
+#include "BenchTimer.h"
+#include "QueueClass.h"
+#include "MinQueueClass.h"
+
+// Минимум скользящего окна: TMinQueue против TQueue::Min
+int main(int argc, char** argv)
+{
+  size_t n = Iterations(argc, argv, 2000000);
+  unsigned seed = 1;
+  auto next = [&] {
+    seed = seed * 1103515245 + 12345;
+    return (int)(seed >> 8);
+  };
+  volatile int sink = 0;
+
+  cout << "window: TMinQueue ns/step, TQueue::Min ns/step\n";
+  for (size_t window = 16; window <= (1 << 20); window *= 4)
+  {
+    TMinQueue<int> mono(window + 1);
+    TQueue<int> plain(window + 2);
+    for (size_t i = 0; i < window; ++i)
+    {
+      int value = next();
+      mono.push(value);
+      plain.push(value);
+    }
+
+    double fast = NsPerIteration(n, [&] {
+      mono.push(next());
+      mono.pop();
+      sink = mono.Min();
+    });
+    // Сканирование стоит O(window) за шаг, поэтому шагов меньше
+    size_t steps = n * 16 / window + 10;
+    double slow = NsPerIteration(steps, [&] {
+      plain.push(next());
+      plain.pop();
+      sink = plain.Min();
+    });
+
+    cout << window << ": " << fast << ", " << slow << "\n";
+  }
+  return 0;
+}
@@ -0,0 +1,77 @@
+#include <iostream>
+#include <algorithm>
+#include <atomic>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "BenchTimer.h"
+#include "QueueClass.h"
+#include "MpmcQueueClass.h"
+
+// Пропускная способность при threads производителях и threads потребителях
+template <class Push, class Pop>
+static double Throughput(size_t threads, size_t perProducer, Push tryPush, Pop tryPop)
+{
+  size_t total = threads * perProducer;
+  atomic<size_t> consumed(0);
+  double ns = NsPerIteration(1, [&] {
+    vector<thread> pool;
+    for (size_t p = 0; p < threads; ++p)
+      pool.emplace_back([&] {
+        for (size_t i = 0; i < perProducer; ++i)
+          while (!tryPush(i))
+            this_thread::yield();
+      });
+    for (size_t c = 0; c < threads; ++c)
+      pool.emplace_back([&] {
+        size_t value;
+        while (consumed.load(memory_order_relaxed) < total)
+        {
+          if (tryPop(value))
+            consumed.fetch_add(1, memory_order_relaxed);
+          else
+            this_thread::yield();
+        }
+      });
+    for (thread& th : pool)
+      th.join();
+  });
+  return total / ns * 1e9;
+}
+
+int main(int argc, char** argv)
+{
+  size_t n = Iterations(argc, argv, 500000);
+  size_t cores = max(1u, thread::hardware_concurrency());
+  const size_t capacity = 1024;
+
+  cout << "producers=consumers, Mops/s: TMpmcQueue vs TQueue + mutex\n";
+  for (size_t threads = 1; threads <= cores; ++threads)
+  {
+    size_t perProducer = n / threads;
+    TMpmcQueue<size_t> mpmc(capacity);
+    double lockFree = Throughput(threads, perProducer, [&](size_t v) { return mpmc.try_push(v); },
+                                 [&](size_t& v) { return mpmc.try_pop(v); });
+
+    TQueue<size_t> queue(capacity);
+    mutex lock;
+    double locked = Throughput(threads, perProducer,
+        [&](size_t v) {
+          lock_guard<mutex> guard(lock);
+          if (queue.IsFull())
+            return false;
+          queue.push(v);
+          return true;
+        },
+        [&](size_t& v) {
+          lock_guard<mutex> guard(lock);
+          if (queue.IsEmpty())
+            return false;
+          v = queue.pop();
+          return true;
+        });
+
+    cout << threads << ": " << lockFree / 1e6 << " vs " << locked / 1e6 << "\n";
+  }
+  return 0;
+}
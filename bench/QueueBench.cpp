@@ -0,0 +1,62 @@
+#include <iostream>
+#include <mutex>
+#include <thread>
+#include "BenchTimer.h"
+#include "QueueClass.h"
+#include "SpscQueueClass.h"
+
+// Передача элементов между двумя потоками: TSpscQueue против TQueue под мьютексом
+template <class Push, class Pop>
+static double Transfer(size_t n, Push tryPush, Pop tryPop)
+{
+  return NsPerIteration(1, [&] {
+    thread producer([&] {
+      for (size_t i = 0; i < n; ++i)
+        while (!tryPush(i))
+          this_thread::yield();
+    });
+    size_t value, received = 0;
+    while (received < n)
+    {
+      if (tryPop(value))
+        received++;
+      else
+        this_thread::yield();
+    }
+    producer.join();
+  }) / n;
+}
+
+int main(int argc, char** argv)
+{
+  size_t n = Iterations(argc, argv, 2000000);
+  const size_t capacity = 1024;
+
+  TSpscQueue<size_t> spsc(capacity);
+  double lockFree = Transfer(n, [&](size_t v) { return spsc.try_push(v); },
+                             [&](size_t& v) { return spsc.try_pop(v); });
+
+  TQueue<size_t> queue(capacity);
+  mutex lock;
+  double locked = Transfer(n,
+      [&](size_t v) {
+        lock_guard<mutex> guard(lock);
+        if (queue.IsFull())
+          return false;
+        queue.push(v);
+        return true;
+      },
+      [&](size_t& v) {
+        lock_guard<mutex> guard(lock);
+        if (queue.IsEmpty())
+          return false;
+        v = queue.pop();
+        return true;
+      });
+
+  cout << "SPSC transfer of " << n << " elements\n";
+  cout << "TQueue + mutex: " << locked << " ns/element\n";
+  cout << "TSpscQueue:     " << lockFree << " ns/element\n";
+  cout << "speedup: " << locked / lockFree << "x\n";
+  return 0;
+}
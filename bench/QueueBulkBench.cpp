@@ -0,0 +1,31 @@
+#include <iostream>
+#include <vector>
+#include "BenchTimer.h"
+#include "QueueClass.h"
+
+// Перенос пакетов через TQueue: по одному элементу против push_bulk/pop_bulk
+int main(int argc, char** argv)
+{
+  size_t n = Iterations(argc, argv, 200000);
+  const size_t capacity = 4099; // пакеты регулярно переходят через конец буфера
+
+  for (size_t batch : {16, 64, 256, 1500})
+  {
+    vector<char> in(batch, 'x'), out(batch);
+    TQueue<char> single(capacity), bulk(capacity);
+
+    double one = NsPerIteration(n, [&] {
+      for (size_t i = 0; i < batch; ++i)
+        single.push(in[i]);
+      for (size_t i = 0; i < batch; ++i)
+        out[i] = single.pop();
+    });
+    double many = NsPerIteration(n, [&] {
+      bulk.push_bulk(in);
+      bulk.pop_bulk(out);
+    });
+
+    cout << batch << " bytes: push/pop " << one << " ns, bulk " << many << " ns, speedup " << one / many << "x\n";
+  }
+  return 0;
+}
@@ -0,0 +1,49 @@
+#include <iostream>
+#include "BenchTimer.h"
+#include "QueueClass.h"
+#include "RingQueueClass.h"
+
+// Индексация по модулю (TQueue) против маски (TRingQueue)
+template <class Q>
+static double PushPop(Q& queue, size_t n)
+{
+  // Очередь держится наполовину заполненной
+  for (size_t i = 0; i < 500; ++i)
+    queue.push(i);
+  volatile size_t sink = 0;
+  return NsPerIteration(n, [&] {
+    queue.push((size_t)sink);
+    sink = queue.pop();
+  });
+}
+
+template <class Q>
+static double Index(Q& queue, size_t n)
+{
+  volatile size_t sink = 0;
+  size_t size = queue.Size();
+  return NsPerIteration(n / size + 1, [&] {
+    size_t sum = 0;
+    for (size_t i = 0; i < size; ++i)
+      sum += queue[i];
+    sink = sum;
+  }) / size;
+}
+
+int main(int argc, char** argv)
+{
+  size_t n = Iterations(argc, argv, 20000000);
+
+  // 1000 ячеек у TQueue против 1024 у TRingQueue
+  TQueue<size_t> modulo(1000);
+  TRingQueue<size_t> masked(1000);
+
+  double moduloPushPop = PushPop(modulo, n);
+  double maskedPushPop = PushPop(masked, n);
+  double moduloIndex = Index(modulo, n);
+  double maskedIndex = Index(masked, n);
+
+  cout << "push+pop:   TQueue " << moduloPushPop << " ns, TRingQueue " << maskedPushPop << " ns\n";
+  cout << "operator[]: TQueue " << moduloIndex << " ns, TRingQueue " << maskedIndex << " ns\n";
+  return 0;
+}
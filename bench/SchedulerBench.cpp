@@ -0,0 +1,73 @@
+#include <iostream>
+#include <algorithm>
+#include <atomic>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "BenchTimer.h"
+#include "FormulaClass.h"
+#include "QueueClass.h"
+#include "SchedulerClass.h"
+
+// Мелкие задания - вычисление скомпилированной формулы для одной строки:
+// пул с перехватом работы против общей очереди TQueue под мьютексом
+int main(int argc, char** argv)
+{
+  size_t count = Iterations(argc, argv, 1000000);
+  size_t cores = max(1u, thread::hardware_concurrency());
+
+  TFormula<double> formula("(a+b)*(a-b)/(1+a*a)", {"a", "b"});
+  formula.FormulaConverter();
+  formula.FormulaOptimizer();
+  const TProgram<double>& program = formula.GetProgram();
+  vector<double> out(count);
+  auto job = [&](size_t i) {
+    double values[2] = {(double)i, 0.5};
+    out[i] = program.Run(values);
+  };
+
+  cout << "threads, grain: work stealing vs locked TQueue, ns/task\n";
+  for (size_t threads = 1; threads <= 2 * cores; threads *= 2)
+    for (size_t grain : {1, 16})
+    {
+      TScheduler scheduler(threads);
+      double stealing = NsPerIteration(1, [&] { scheduler.ParallelFor(count, grain, job); }) / count;
+
+      // Потоки базового варианта создаются до замера, как у пула;
+      // раздача кусков входит в замер в обоих вариантах
+      size_t chunks = (count + grain - 1) / grain;
+      TQueue<size_t> queue(chunks + 1);
+      mutex lock;
+      atomic<bool> go(false);
+      auto worker = [&] {
+        while (!go.load(memory_order_acquire))
+          this_thread::yield();
+        for (;;)
+        {
+          size_t chunk;
+          {
+            lock_guard<mutex> guard(lock);
+            if (queue.IsEmpty())
+              return;
+            chunk = queue.pop();
+          }
+          for (size_t i = chunk * grain; i < min((chunk + 1) * grain, count); ++i)
+            job(i);
+        }
+      };
+      vector<thread> pool;
+      for (size_t t = 1; t < threads; ++t)
+        pool.emplace_back(worker);
+      double locked = NsPerIteration(1, [&] {
+        for (size_t c = 0; c < chunks; ++c)
+          queue.push(c);
+        go.store(true, memory_order_release);
+        worker();
+        for (thread& th : pool)
+          th.join();
+      }) / count;
+
+      cout << threads << ", " << grain << ": " << stealing << " vs " << locked << "\n";
+    }
+  return 0;
+}
@@ -0,0 +1,51 @@
+#include <iostream>
+#include <string>
+#include <vector>
+#include "BenchTimer.h"
+#include "StackClass.h"
+
+// Заполнение и опустошение TStack тяжелыми элементами с ростом от малой емкости:
+// копирование (push(const T&), копия результата pop) против push(T&&) и pop_into
+template <class T>
+void Run(const char* name, const T& sample, size_t count, size_t repeats)
+{
+  volatile size_t sink = 0;
+  double copying = NsPerIteration(repeats, [&] {
+    TStack<T> stack(1);
+    for (size_t i = 0; i < count; ++i)
+    {
+      T element = sample;
+      stack.push(element);
+    }
+    while (!stack.IsEmpty())
+    {
+      T element = stack.Peek();
+      stack.pop();
+      sink = sink + element.size();
+    }
+  });
+  double moving = NsPerIteration(repeats, [&] {
+    TStack<T> stack(1);
+    for (size_t i = 0; i < count; ++i)
+    {
+      T element = sample;
+      stack.push(std::move(element));
+    }
+    T element;
+    while (!stack.IsEmpty())
+    {
+      stack.pop_into(element);
+      sink = sink + element.size();
+    }
+  });
+  cout << name << ": copy " << copying / count << " ns/element, move " << moving / count
+       << " ns/element, speedup " << copying / moving << "x\n";
+}
+
+int main(int argc, char** argv)
+{
+  size_t count = Iterations(argc, argv, 100000);
+  Run<string>("string(64)", string(64, 'x'), count, 20);
+  Run<vector<int>>("vector<int>(32)", vector<int>(32, 1), count, 20);
+  return 0;
+}
@@ -0,0 +1 @@
+#include "BatchClass.h"
\ No newline at end of file
@@ -0,0 +1,179 @@
+#pragma once
+#include <cstddef>
+#include <charconv>
+#include <exception>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "FormulaClass.h"
+#include "SchedulerClass.h"
+
+using namespace std;
+
+// Пакетное вычисление выражений: одно выражение в строке.
+// Этапы (проверка скобок, перевод, вычисление) выполняются на общем пуле потоков.
+// Ошибка любого этапа записывается в свою строку и не прерывает остальные.
+template <class T>
+class TBatch
+{
+protected:
+  TScheduler& scheduler;
+  vector<string_view> lines;
+  vector<TFormula<T>> formulas;
+  vector<string> errors; // пустая строка - ошибок нет
+  vector<T> results;
+
+  static constexpr size_t Grain = 64;
+
+  // Вызов f для строки i с перехватом исключений в errors[i]
+  template <class F>
+  void Guard(size_t i, F f);
+public:
+  // Строки должны жить дольше пакета
+  TBatch(TScheduler& scheduler_, const vector<string_view>& lines_);
+  TBatch(const TBatch& other) = delete;
+
+  size_t Size() const;
+
+  void Check();
+  void Convert();
+  void Evaluate();
+  // Все этапы подряд
+  void Run();
+
+  bool IsError(size_t index) const;
+  const string& GetError(size_t index) const;
+  T GetResult(size_t index) const;
+
+  // Результат или "error: <текст>" по строке на выражение
+  void Write(string& text) const;
+};
+
+template <class T>
+inline TBatch<T>::TBatch(TScheduler& scheduler_, const vector<string_view>& lines_)
+    : scheduler(scheduler_), lines(lines_), errors(lines_.size()), results(lines_.size())
+{
+  formulas.reserve(lines.size());
+  for (string_view line : lines)
+    formulas.emplace_back(line);
+}
+
+template <class T>
+template <class F>
+inline void TBatch<T>::Guard(size_t i, F f)
+{
+  try
+  {
+    f();
+  }
+  catch (const char* error)
+  {
+    errors[i] = error;
+  }
+  catch (const exception& error)
+  {
+    errors[i] = error.what();
+  }
+}
+
+template <class T>
+inline size_t TBatch<T>::Size() const
+{
+  return lines.size();
+}
+
+template <class T>
+inline void TBatch<T>::Check()
+{
+  scheduler.ParallelFor(Size(), Grain, [&](size_t i) {
+    if (lines[i].empty())
+    {
+      errors[i] = "empty expression";
+      return;
+    }
+    Guard(i, [&] {
+      // Каждая скобка дает не больше двух чисел
+      size_t brackets = 0;
+      for (char c : lines[i])
+        brackets += (c == '(' || c == ')');
+      vector<int> positions(2 * brackets + 1);
+      if (formulas[i].FormulaChecker(positions.data(), positions.size()) > 0)
+        errors[i] = "unbalanced brackets";
+    });
+  });
+}
+
+template <class T>
+inline void TBatch<T>::Convert()
+{
+  scheduler.ParallelFor(Size(), Grain, [&](size_t i) {
+    if (IsError(i))
+      return;
+    Guard(i, [&] {
+      formulas[i].FormulaConverter();
+      formulas[i].FormulaOptimizer();
+    });
+  });
+}
+
+template <class T>
+inline void TBatch<T>::Evaluate()
+{
+  scheduler.ParallelFor(Size(), Grain, [&](size_t i) {
+    if (IsError(i))
+      return;
+    Guard(i, [&] { results[i] = formulas[i].FormulaCalculator(); });
+  });
+}
+
+template <class T>
+inline void TBatch<T>::Run()
+{
+  Check();
+  Convert();
+  Evaluate();
+}
+
+template <class T>
+inline bool TBatch<T>::IsError(size_t index) const
+{
+  return !errors[index].empty();
+}
+
+template <class T>
+inline const string& TBatch<T>::GetError(size_t index) const
+{
+  if (index >= Size())
+    throw "Index out of range";
+  return errors[index];
+}
+
+template <class T>
+inline T TBatch<T>::GetResult(size_t index) const
+{
+  if (index >= Size())
+    throw "Index out of range";
+  if (IsError(index))
+    throw "Expression has an error";
+  return results[index];
+}
+
+template <class T>
+inline void TBatch<T>::Write(string& text) const
+{
+  char number[64];
+  for (size_t i = 0; i < Size(); ++i)
+  {
+    if (IsError(i))
+    {
+      text += "error: ";
+      text += errors[i];
+    } else
+    {
+      // Кратчайшая запись, читаемая обратно в то же значение
+      char* end = to_chars(number, number + sizeof(number), results[i]).ptr;
+      text.append(number, end);
+    }
+    text += '\n';
+  }
+}
@@ -0,0 +1 @@
+#include "CacheClass.h"
\ No newline at end of file
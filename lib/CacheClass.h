@@ -0,0 +1,170 @@
+#pragma once
+#include <cstddef>
+#include <atomic>
+#include <functional>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+#include "FormulaClass.h"
+
+using namespace std;
+
+// Скомпилированная формула: программа и имена переменных по номерам ячеек
+template <class T>
+struct TCompiledFormula
+{
+  TProgram<T> program;
+  vector<string> variables;
+};
+
+// Кэш скомпилированных формул по тексту выражения.
+// Делится на сегменты со своей блокировкой и своей очередью LRU.
+template <class T>
+class TFormulaCache
+{
+public:
+  typedef shared_ptr<const TCompiledFormula<T>> TEntry;
+protected:
+  struct TShard
+  {
+    mutex lock;
+    // Начало списка - последние использованные; ключи карты ссылаются на строки списка
+    list<pair<string, TEntry>> order;
+    unordered_map<string_view, typename list<pair<string, TEntry>>::iterator> index;
+  };
+
+  size_t shardCapacity;
+  vector<TShard> shards;
+  atomic<size_t> hits;
+  atomic<size_t> misses;
+  atomic<size_t> evictions;
+
+  TShard& ShardOf(string_view text);
+  static TEntry Compile(string_view text);
+public:
+  TFormulaCache(size_t capacity = 4096, size_t shardCount = 16);
+  TFormulaCache(const TFormulaCache& other) = delete;
+
+  // Скомпилированная формула; при промахе выражение разбирается и сохраняется
+  TEntry Get(string_view text);
+  void Clear();
+
+  size_t Size();
+  size_t GetCapacity() const;
+  size_t GetHits() const;
+  size_t GetMisses() const;
+  size_t GetEvictions() const;
+};
+
+template <class T>
+inline TFormulaCache<T>::TFormulaCache(size_t capacity, size_t shardCount)
+    : shards(shardCount > 0 ? shardCount : 1), hits(0), misses(0), evictions(0)
+{
+  if (capacity == 0)
+    throw "Cache capacity must be positive";
+  shardCapacity = (capacity + shards.size() - 1) / shards.size();
+}
+
+template <class T>
+inline typename TFormulaCache<T>::TShard& TFormulaCache<T>::ShardOf(string_view text)
+{
+  return shards[hash<string_view>()(text) % shards.size()];
+}
+
+template <class T>
+inline typename TFormulaCache<T>::TEntry TFormulaCache<T>::Compile(string_view text)
+{
+  TFormula<T> formula(text);
+  formula.FormulaConverter();
+  formula.FormulaOptimizer();
+  return make_shared<const TCompiledFormula<T>>(TCompiledFormula<T>{formula.GetProgram(), formula.GetVariables()});
+}
+
+template <class T>
+inline typename TFormulaCache<T>::TEntry TFormulaCache<T>::Get(string_view text)
+{
+  TShard& shard = ShardOf(text);
+  {
+    lock_guard<mutex> guard(shard.lock);
+    auto it = shard.index.find(text);
+    if (it != shard.index.end())
+    {
+      shard.order.splice(shard.order.begin(), shard.order, it->second);
+      hits.fetch_add(1, memory_order_relaxed);
+      return it->second->second;
+    }
+  }
+
+  // Разбор идет без блокировки, чтобы не задерживать другие запросы к сегменту
+  misses.fetch_add(1, memory_order_relaxed);
+  TEntry compiled = Compile(text);
+
+  lock_guard<mutex> guard(shard.lock);
+  auto it = shard.index.find(text);
+  if (it != shard.index.end())
+  {
+    // Другой поток успел добавить ту же формулу
+    shard.order.splice(shard.order.begin(), shard.order, it->second);
+    return it->second->second;
+  }
+  shard.order.emplace_front(string(text), compiled);
+  shard.index.emplace(shard.order.front().first, shard.order.begin());
+  if (shard.order.size() > shardCapacity)
+  {
+    shard.index.erase(shard.order.back().first);
+    shard.order.pop_back();
+    evictions.fetch_add(1, memory_order_relaxed);
+  }
+  return compiled;
+}
+
+template <class T>
+inline void TFormulaCache<T>::Clear()
+{
+  for (TShard& shard : shards)
+  {
+    lock_guard<mutex> guard(shard.lock);
+    shard.index.clear();
+    shard.order.clear();
+  }
+}
+
+template <class T>
+inline size_t TFormulaCache<T>::Size()
+{
+  size_t size = 0;
+  for (TShard& shard : shards)
+  {
+    lock_guard<mutex> guard(shard.lock);
+    size += shard.order.size();
+  }
+  return size;
+}
+
+template <class T>
+inline size_t TFormulaCache<T>::GetCapacity() const
+{
+  return shardCapacity * shards.size();
+}
+
+template <class T>
+inline size_t TFormulaCache<T>::GetHits() const
+{
+  return hits.load(memory_order_relaxed);
+}
+
+template <class T>
+inline size_t TFormulaCache<T>::GetMisses() const
+{
+  return misses.load(memory_order_relaxed);
+}
+
+template <class T>
+inline size_t TFormulaCache<T>::GetEvictions() const
+{
+  return evictions.load(memory_order_relaxed);
+}
\ No newline at end of file
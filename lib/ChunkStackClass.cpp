@@ -0,0 +1 @@
+#include "ChunkStackClass.h"
\ No newline at end of file
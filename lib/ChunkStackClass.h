@@ -0,0 +1,226 @@
+#pragma once
+#include <cstddef>
+#include <memory>
+#include <type_traits>
+#include <utility>
+
+using namespace std;
+
+// Стек из цепочки блоков по ChunkSize элементов.
+// Рост - подключение нового блока, элементы никогда не копируются,
+// поэтому push и pop выполняются за O(1) в худшем случае, а не амортизированно.
+// Опустевший блок остается запасным: push и pop на границе блоков не выделяют память.
+// Второй опустевший блок возвращается аллокатору.
+template <class T, size_t ChunkSize = (4096 / sizeof(T) > 0 ? 4096 / sizeof(T) : 1), class Allocator = allocator<T>>
+class TChunkStack
+{
+  static_assert(ChunkSize > 0, "Chunk size must be positive");
+protected:
+  struct TChunk
+  {
+    TChunk* prev; // блок ниже
+    alignas(T) unsigned char data[ChunkSize * sizeof(T)];
+
+    T* Items() { return reinterpret_cast<T*>(data); }
+  };
+
+  using TTraits = allocator_traits<Allocator>;
+  using TChunkAllocator = typename TTraits::template rebind_alloc<TChunk>;
+  using TChunkTraits = allocator_traits<TChunkAllocator>;
+
+  TChunk* current; // блок с вершиной
+  TChunk* spare;   // запасной пустой блок
+  size_t used;     // занято в current
+  size_t size;
+  Allocator alloc;
+  TChunkAllocator chunkAlloc;
+
+  // Следующий блок: запасной или новый
+  void Link();
+  // Переход на блок ниже, опустевший блок становится запасным
+  void Unlink();
+  void FreeChunk(TChunk* chunk);
+public:
+  explicit TChunkStack(const Allocator& alloc_ = Allocator());
+  TChunkStack(const TChunkStack& other) = delete;
+  TChunkStack(TChunkStack&& other);
+  ~TChunkStack();
+
+  size_t Size() const;
+  bool IsEmpty() const;
+  // Число выделенных блоков вместе с запасным
+  size_t GetChunkCount() const;
+
+  void push(const T& element);
+  void push(T&& element);
+  template <class... Args>
+  T& emplace(Args&&... args);
+  T pop();
+  void pop_into(T& element);
+  T Peek() const;
+
+  // Удаление всех элементов; все блоки возвращаются аллокатору
+  void Clear();
+  // Возврат запасного блока
+  void ShrinkToFit();
+};
+
+template <class T, size_t ChunkSize, class Allocator>
+inline TChunkStack<T, ChunkSize, Allocator>::TChunkStack(const Allocator& alloc_)
+    : current(nullptr), spare(nullptr), used(0), size(0), alloc(alloc_), chunkAlloc(alloc_) {}
+
+template <class T, size_t ChunkSize, class Allocator>
+inline TChunkStack<T, ChunkSize, Allocator>::TChunkStack(TChunkStack&& other)
+    : current(other.current), spare(other.spare), used(other.used), size(other.size),
+      alloc(std::move(other.alloc)), chunkAlloc(std::move(other.chunkAlloc))
+{
+  other.current = nullptr;
+  other.spare = nullptr;
+  other.used = 0;
+  other.size = 0;
+}
+
+template <class T, size_t ChunkSize, class Allocator>
+inline TChunkStack<T, ChunkSize, Allocator>::~TChunkStack()
+{
+  Clear();
+}
+
+template <class T, size_t ChunkSize, class Allocator>
+inline void TChunkStack<T, ChunkSize, Allocator>::FreeChunk(TChunk* chunk)
+{
+  if (chunk)
+    TChunkTraits::deallocate(chunkAlloc, chunk, 1);
+}
+
+template <class T, size_t ChunkSize, class Allocator>
+inline void TChunkStack<T, ChunkSize, Allocator>::Link()
+{
+  TChunk* chunk = spare;
+  if (chunk)
+    spare = nullptr;
+  else
+    chunk = TChunkTraits::allocate(chunkAlloc, 1);
+  chunk->prev = current;
+  current = chunk;
+  used = 0;
+}
+
+template <class T, size_t ChunkSize, class Allocator>
+inline void TChunkStack<T, ChunkSize, Allocator>::Unlink()
+{
+  TChunk* empty = current;
+  current = current->prev;
+  used = ChunkSize;
+  FreeChunk(spare);
+  spare = empty;
+}
+
+template <class T, size_t ChunkSize, class Allocator>
+inline size_t TChunkStack<T, ChunkSize, Allocator>::Size() const
+{
+  return size;
+}
+
+template <class T, size_t ChunkSize, class Allocator>
+inline bool TChunkStack<T, ChunkSize, Allocator>::IsEmpty() const
+{
+  return size == 0;
+}
+
+template <class T, size_t ChunkSize, class Allocator>
+inline size_t TChunkStack<T, ChunkSize, Allocator>::GetChunkCount() const
+{
+  size_t count = spare ? 1 : 0;
+  for (TChunk* chunk = current; chunk; chunk = chunk->prev)
+    count++;
+  return count;
+}
+
+template <class T, size_t ChunkSize, class Allocator>
+inline void TChunkStack<T, ChunkSize, Allocator>::push(const T& element)
+{
+  emplace(element);
+}
+
+template <class T, size_t ChunkSize, class Allocator>
+inline void TChunkStack<T, ChunkSize, Allocator>::push(T&& element)
+{
+  emplace(std::move(element));
+}
+
+template <class T, size_t ChunkSize, class Allocator>
+template <class... Args>
+inline T& TChunkStack<T, ChunkSize, Allocator>::emplace(Args&&... args)
+{
+  // Старые блоки не перемещаются, поэтому аргументы могут ссылаться на элементы стека
+  if (!current || used == ChunkSize)
+    Link();
+  T* slot = current->Items() + used;
+  TTraits::construct(alloc, slot, std::forward<Args>(args)...);
+  used++;
+  size++;
+  return *slot;
+}
+
+template <class T, size_t ChunkSize, class Allocator>
+inline T TChunkStack<T, ChunkSize, Allocator>::pop()
+{
+  if (IsEmpty())
+    throw "Stack is empty";
+  if (used == 0)
+    Unlink();
+  T* slot = current->Items() + --used;
+  T element = std::move(*slot);
+  TTraits::destroy(alloc, slot);
+  size--;
+  return element;
+}
+
+template <class T, size_t ChunkSize, class Allocator>
+inline void TChunkStack<T, ChunkSize, Allocator>::pop_into(T& element)
+{
+  if (IsEmpty())
+    throw "Stack is empty";
+  if (used == 0)
+    Unlink();
+  T* slot = current->Items() + --used;
+  element = std::move(*slot);
+  TTraits::destroy(alloc, slot);
+  size--;
+}
+
+template <class T, size_t ChunkSize, class Allocator>
+inline T TChunkStack<T, ChunkSize, Allocator>::Peek() const
+{
+  if (IsEmpty())
+    throw "Stack is empty";
+  if (used == 0)
+    return current->prev->Items()[ChunkSize - 1];
+  return current->Items()[used - 1];
+}
+
+template <class T, size_t ChunkSize, class Allocator>
+inline void TChunkStack<T, ChunkSize, Allocator>::Clear()
+{
+  while (current)
+  {
+    if constexpr (!is_trivially_destructible_v<T>)
+      for (size_t i = 0; i < used; ++i)
+        TTraits::destroy(alloc, current->Items() + i);
+    TChunk* prev = current->prev;
+    FreeChunk(current);
+    current = prev;
+    used = ChunkSize;
+  }
+  ShrinkToFit();
+  used = 0;
+  size = 0;
+}
+
+template <class T, size_t ChunkSize, class Allocator>
+inline void TChunkStack<T, ChunkSize, Allocator>::ShrinkToFit()
+{
+  FreeChunk(spare);
+  spare = nullptr;
+}
\ No newline at end of file
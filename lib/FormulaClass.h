@@ -1,20 +1,53 @@
 #pragma once
 
 #include <cstring>
-#include "StackClass.h"
+#include "SmallStackClass.h"
+#include "ProgramClass.h"
+#include "TreeClass.h"
 #include <cctype>
+#include <climits>
 #include <sstream>
+#include <charconv>
+#include <type_traits>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <unordered_map>
 
-const int MaxLength = 255;
 using namespace std;
 
+// Разбор числа из [first, last) без потоков и выделения памяти.
+// Результат совпадает с istringstream >> T; значения вне диапазона T
+// (редкий случай) разбираются через istringstream.
+template<class T>
+T ParseNumber(const char* first, const char* last)
+{
+  if constexpr (is_integral_v<T> || is_same_v<T, float> || is_same_v<T, double>)
+  {
+    T num = T();
+    from_chars_result res = from_chars(first, last, num);
+    if (res.ec == errc())
+      return num;
+    if (res.ec == errc::invalid_argument)
+      return T();
+  }
+  T num;
+  istringstream(string(first, last)) >> num;
+  return num;
+}
+
 template<class T>
 class TFormula
 {
 private:
-  char Formula[MaxLength];
-  char PostfixForm[MaxLength];
-  int getPriority(char op)
+  string Formula;
+  string PostfixForm;
+  TProgram<T> Program;
+  TExprTree<T> Tree;
+  vector<string> Variables;              // имена переменных по номерам ячеек
+  unordered_map<string, unsigned> Slots; // номер ячейки по имени
+  static int getPriority(char op)
   {
     switch (op)
     {
@@ -30,48 +63,98 @@ private:
         return -1;
     }
   }
+  static bool isIdentifierStart(char c)
+  {
+    return isalpha((unsigned char)c) || c == '_';
+  }
+  unsigned Bind(string_view name)
+  {
+    string key(name);
+    auto it = Slots.find(key);
+    if (it != Slots.end())
+      return it->second;
+    unsigned slot = Variables.size();
+    Variables.push_back(key);
+    Slots.emplace(std::move(key), slot);
+    return slot;
+  }
+  void PutOperator(char op)
+  {
+    PostfixForm += op;
+    PostfixForm += ' ';
+    Program.PushOperator(op);
+  }
 public:
-  TFormula(char form[]);
+  TFormula(string_view form);
+  // names задает номера ячеек заранее, новые имена добавляются в конец
+  TFormula(string_view form, const vector<string>& names);
+  // Пары позиций скобок (с единицы, 0 - нет пары) в Brackets[0..size); возвращает число ошибок.
+  // Нужно 2 числа на каждую скобку ')' и на каждую незакрытую '('
   int FormulaChecker(int Brackets[], int size);
   int FormulaConverter();
+  // Упрощение программы после FormulaConverter; возвращает число удаленных операций
+  int FormulaOptimizer();
   T FormulaCalculator();
+  // values[k] - значение переменной в ячейке k
+  T FormulaCalculator(const T* values);
+  // Пакетное вычисление: out[row] для значений переменных columns[k][row]
+  void EvaluateBatch(span<const T* const> columns, span<T> out) const;
+  // Вычисление по тексту постфиксной формы (медленный путь для сравнения)
+  T PostfixCalculator();
+  // Разбор и вычисление за один проход, без постфиксной формы и программы
+  static T Evaluate(string_view form);
+  const TProgram<T>& GetProgram() const;
+  // Дерево выражения по текущей программе
+  const TExprTree<T>& BuildTree();
+  // Имена переменных по номерам ячеек; у формул с $k список пуст
+  const vector<string>& GetVariables() const;
+  // Номер ячейки переменной или -1
+  int GetSlot(const string& name) const;
 };
 
 template<class T>
-TFormula<T>::TFormula(char form[])
+TFormula<T>::TFormula(string_view form) : Formula(form) {}
+
+template<class T>
+TFormula<T>::TFormula(string_view form, const vector<string>& names) : TFormula(form)
 {
-  strncpy(Formula, form, MaxLength - 1);
-  Formula[MaxLength - 1] = '\0';
-  PostfixForm[0] = '\0';
+  for (const string& name : names)
+    Bind(name);
 }
 
 template<class T>
 int TFormula<T>::FormulaChecker(int Brackets[], int size)
 {
-  TStack<int> stack;
+  // Позиции скобок хранятся в int
+  if (Formula.size() >= (size_t)INT_MAX)
+    throw "Formula is too long";
+  // Стек растет вместе с вложенностью, Brackets - не больше size чисел
+  TSmallStack<int> stack;
   int errors = 0;
   int idx = 0;
-  for (int i = 0; Formula[i]; ++i)
+  auto put = [&](int open, int close)
   {
-    if (Formula[i] == '(') stack.push(i + 1);
+    if (idx > size - 2)
+      throw "Brackets array is too small";
+    Brackets[idx++] = open;
+    Brackets[idx++] = close;
+  };
+  for (size_t i = 0; i < Formula.size(); ++i)
+  {
+    if (Formula[i] == '(') stack.push((int)i + 1);
     else if (Formula[i] == ')')
     {
       if (stack.IsEmpty())
       {
-        Brackets[idx++] = 0;
-        Brackets[idx++] = i + 1;
+        put(0, (int)i + 1);
         errors++;
       } else
-      {
-        Brackets[idx++] = stack.pop();
-        Brackets[idx++] = i + 1;
-      }
+        put(stack.pop(), (int)i + 1);
     }
   }
   while (!stack.IsEmpty())
   {
-    Brackets[idx++] = stack.pop();
-    Brackets[idx++] = 0;
+    put(stack.pop(), 0);
     errors++;
   }
   return errors;
@@ -80,44 +163,116 @@ int TFormula<T>::FormulaChecker(int Brackets[], int size)
 template<class T>
 int TFormula<T>::FormulaConverter()
 {
-  TStack<char> ops;
-  int i = 0, j = 0;
+  TSmallStack<char> ops;
+  // Имена и $k нумеруют одни и те же ячейки, поэтому вместе не допускаются
+  bool numbered = false;
+  Program.Clear();
+  PostfixForm.clear();
+  // Каждая лексема получает не больше одного пробела
+  PostfixForm.reserve(2 * Formula.size());
+  size_t i = 0;
   while (Formula[i])
   {
     if (isdigit(Formula[i]) || Formula[i] == '.')
     {
+      size_t begin = i;
       while (isdigit(Formula[i]) || Formula[i] == '.')
-        PostfixForm[j++] = Formula[i++];
-      PostfixForm[j++] = ' ';
+        i++;
+      // Константа разбирается один раз при компиляции
+      Program.PushConst(ParseNumber<T>(Formula.data() + begin, Formula.data() + i));
+      PostfixForm.append(Formula, begin, i - begin);
+      PostfixForm += ' ';
+      continue;
+    }
+    if (isIdentifierStart(Formula[i]))
+    {
+      // Имя переменной связывается с ячейкой один раз при компиляции
+      if (numbered)
+        throw "Named and numbered variables cannot be mixed";
+      size_t begin = i;
+      while (isIdentifierStart(Formula[i]) || isdigit(Formula[i]))
+        i++;
+      string_view name(Formula.data() + begin, i - begin);
+      Program.PushVariable(Bind(name));
+      PostfixForm += name;
+      PostfixForm += ' ';
+      continue;
+    }
+    if (Formula[i] == '$' && isdigit(Formula[i + 1]))
+    {
+      // $k - ссылка на ячейку k (столбец в пакетном режиме)
+      if (!Variables.empty())
+        throw "Named and numbered variables cannot be mixed";
+      numbered = true;
+      size_t begin = i++;
+      while (isdigit(Formula[i]))
+        i++;
+      unsigned slot = 0;
+      from_chars_result res = from_chars(Formula.data() + begin + 1, Formula.data() + i, slot);
+      if (res.ec != errc() || slot > TProgram<T>::MaxSlot)
+        throw "Slot index is too large";
+      Program.PushVariable(slot);
+      PostfixForm.append(Formula, begin, i - begin);
+      PostfixForm += ' ';
       continue;
     }
     if (Formula[i] == '(') ops.push(Formula[i++]);
     else if (Formula[i] == ')')
     {
-      while (!ops.IsEmpty() && ops.GetTop() != '(')
-        PostfixForm[j++] = ops.pop();
-      if (!ops.IsEmpty() && ops.GetTop() == '(') ops.pop();
+      while (!ops.IsEmpty() && ops.Peek() != '(')
+        PutOperator(ops.pop());
+      if (!ops.IsEmpty() && ops.Peek() == '(') ops.pop();
       i++;
     } else if (strchr("+-*/", Formula[i]))
     {
-      while (!ops.IsEmpty() && getPriority(ops.GetTop()) >= getPriority(Formula[i]))
-        PostfixForm[j++] = ops.pop();
+      while (!ops.IsEmpty() && getPriority(ops.Peek()) >= getPriority(Formula[i]))
+        PutOperator(ops.pop());
       ops.push(Formula[i++]);
     } else i++;
   }
-  while (!ops.IsEmpty()) PostfixForm[j++] = ops.pop();
-  PostfixForm[j] = '\0';
+  while (!ops.IsEmpty())
+  {
+    char op = ops.pop();
+    if (op != '(') PutOperator(op); // незакрытая скобка
+  }
   return 0;
 }
 
+template<class T>
+int TFormula<T>::FormulaOptimizer()
+{
+  // PostfixForm не меняется, упрощается только программа
+  return Program.Optimize();
+}
+
 template<class T>
 T TFormula<T>::FormulaCalculator()
 {
-  TStack<T> values;
+  return Program.Run();
+}
+
+template<class T>
+T TFormula<T>::FormulaCalculator(const T* values)
+{
+  return Program.Run(values);
+}
+
+template<class T>
+void TFormula<T>::EvaluateBatch(span<const T* const> columns, span<T> out) const
+{
+  Program.RunBatch(columns.data(), columns.size(), out.data(), out.size());
+}
+
+template<class T>
+T TFormula<T>::PostfixCalculator()
+{
+  TSmallStack<T> values;
   std::istringstream iss(PostfixForm);
   std::string token;
   while (iss >> token)
   {
+    if (token[0] == '$' || isIdentifierStart(token[0]))
+      throw "Variables are not bound";
     if (isdigit(token[0]) || (token[0] == '-' && isdigit(token[1])))
     {
       T num;
@@ -145,4 +300,96 @@ T TFormula<T>::FormulaCalculator()
     }
   }
   return values.pop();
+}
+
+template<class T>
+T TFormula<T>::Evaluate(string_view form)
+{
+  TSmallStack<char> ops;
+  TSmallStack<T> values;
+  // Операция с вершины стека операций сразу применяется к стеку значений
+  auto reduce = [&]()
+  {
+    char op = ops.pop();
+    T b = values.pop();
+    T a = values.pop();
+    switch (op)
+    {
+      case '+':
+        values.push(a + b);
+        break;
+      case '-':
+        values.push(a - b);
+        break;
+      case '*':
+        values.push(a * b);
+        break;
+      case '/':
+        values.push(a / b);
+        break;
+    }
+  };
+
+  size_t i = 0, n = form.size();
+  while (i < n && form[i])
+  {
+    char c = form[i];
+    if (isdigit(c) || c == '.')
+    {
+      size_t begin = i;
+      while (i < n && (isdigit(form[i]) || form[i] == '.'))
+        i++;
+      values.push(ParseNumber<T>(form.data() + begin, form.data() + i));
+      continue;
+    }
+    if (isIdentifierStart(c) || (c == '$' && i + 1 < n && isdigit(form[i + 1])))
+      throw "Variables are not bound";
+    if (c == '(') ops.push(c);
+    else if (c == ')')
+    {
+      while (!ops.IsEmpty() && ops.Peek() != '(')
+        reduce();
+      if (!ops.IsEmpty()) ops.pop();
+    } else if (strchr("+-*/", c))
+    {
+      while (!ops.IsEmpty() && getPriority(ops.Peek()) >= getPriority(c))
+        reduce();
+      ops.push(c);
+    }
+    i++;
+  }
+  while (!ops.IsEmpty())
+  {
+    if (ops.Peek() == '(') ops.pop(); // незакрытая скобка
+    else reduce();
+  }
+  return values.pop();
+}
+
+template<class T>
+const TProgram<T>& TFormula<T>::GetProgram() const
+{
+  return Program;
+}
+
+template<class T>
+const TExprTree<T>& TFormula<T>::BuildTree()
+{
+  Tree.Build(Program);
+  return Tree;
+}
+
+template<class T>
+const vector<string>& TFormula<T>::GetVariables() const
+{
+  return Variables;
+}
+
+template<class T>
+int TFormula<T>::GetSlot(const string& name) const
+{
+  auto it = Slots.find(name);
+  if (it == Slots.end())
+    return -1;
+  return it->second;
 }
\ No newline at end of file
@@ -0,0 +1 @@
+#include "LockFreeStackClass.h"
\ No newline at end of file
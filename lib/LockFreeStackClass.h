@@ -0,0 +1,241 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <atomic>
+#include "SpscQueueClass.h"
+
+using namespace std;
+
+// Ограниченный стек для многих потоков без блокировок (стек Трайбера).
+// Узлы берутся из заранее выделенного пула, вершина и список свободных узлов -
+// 64-битные слова из номера узла и счетчика изменений: счетчик растет при каждом CAS,
+// поэтому вернувшийся на вершину тот же узел не обманет CAS (проблема ABA).
+// При неудачном CAS на вершине поток пробует встретиться с парной операцией
+// в массиве исключения: push передает узел pop напрямую, минуя вершину.
+template <class T>
+class TLockFreeStack
+{
+protected:
+  static constexpr uint32_t Null = 0xFFFFFFFFu;
+  static constexpr size_t EliminationSlots = 8;
+  static constexpr int EliminationSpin = 64;
+
+  struct TNode
+  {
+    T data;
+    atomic<uint32_t> next;
+  };
+
+  // Ячейка массива исключения: предложенный push узел или Null
+  struct alignas(CacheLine) TSlot
+  {
+    atomic<uint64_t> value;
+  };
+
+  size_t capacity;
+  TNode* nodes;
+  TSlot slots[EliminationSlots];
+  alignas(CacheLine) atomic<uint64_t> head;     // вершина стека
+  alignas(CacheLine) atomic<uint64_t> freeList; // свободные узлы
+  char padding[CacheLine - sizeof(atomic<uint64_t>)];
+
+  static uint64_t Tagged(uint64_t word, uint32_t index);
+  static uint32_t Index(uint64_t word);
+
+  uint32_t PopNode(atomic<uint64_t>& list);
+  bool TryPushNode(atomic<uint64_t>& list, uint32_t index);
+  void PushNode(atomic<uint64_t>& list, uint32_t index);
+
+  TSlot& RandomSlot();
+  bool EliminatePush(uint32_t index);
+  bool EliminatePop(uint32_t& index);
+public:
+  TLockFreeStack(size_t capacity_);
+  TLockFreeStack(const TLockFreeStack& other) = delete;
+  ~TLockFreeStack();
+
+  size_t GetCapacity() const;
+
+  bool try_push(const T& element);
+  void push(const T& element);
+  bool try_pop(T& element);
+  T pop();
+
+  // При одновременных операциях значения приблизительны
+  bool IsEmpty() const;
+  bool IsFull() const;
+};
+
+template <class T>
+inline TLockFreeStack<T>::TLockFreeStack(size_t capacity_) : capacity(capacity_)
+{
+  if (capacity_ == 0 || capacity_ >= Null)
+    throw "Stack capacity must be positive";
+  nodes = new TNode[capacity];
+  // Все узлы свободны и связаны по порядку
+  for (size_t i = 0; i < capacity; ++i)
+    nodes[i].next.store(i + 1 < capacity ? (uint32_t)(i + 1) : Null, memory_order_relaxed);
+  freeList.store(0, memory_order_relaxed);
+  head.store(Null, memory_order_relaxed);
+  for (TSlot& slot : slots)
+    slot.value.store(Null, memory_order_relaxed);
+}
+
+template <class T>
+inline TLockFreeStack<T>::~TLockFreeStack()
+{
+  delete[] nodes;
+}
+
+template <class T>
+inline size_t TLockFreeStack<T>::GetCapacity() const
+{
+  return capacity;
+}
+
+template <class T>
+inline uint64_t TLockFreeStack<T>::Tagged(uint64_t word, uint32_t index)
+{
+  // Новый счетчик на единицу больше прежнего
+  return (((word >> 32) + 1) << 32) | index;
+}
+
+template <class T>
+inline uint32_t TLockFreeStack<T>::Index(uint64_t word)
+{
+  return (uint32_t)word;
+}
+
+template <class T>
+inline uint32_t TLockFreeStack<T>::PopNode(atomic<uint64_t>& list)
+{
+  uint64_t top = list.load(memory_order_acquire);
+  for (;;)
+  {
+    uint32_t index = Index(top);
+    if (index == Null)
+      return Null;
+    // Узел мог уже уйти к другому потоку: тогда CAS не пройдет по счетчику
+    uint32_t next = nodes[index].next.load(memory_order_relaxed);
+    if (list.compare_exchange_weak(top, Tagged(top, next), memory_order_acq_rel, memory_order_acquire))
+      return index;
+  }
+}
+
+template <class T>
+inline bool TLockFreeStack<T>::TryPushNode(atomic<uint64_t>& list, uint32_t index)
+{
+  uint64_t top = list.load(memory_order_relaxed);
+  nodes[index].next.store(Index(top), memory_order_relaxed);
+  return list.compare_exchange_strong(top, Tagged(top, index), memory_order_acq_rel, memory_order_relaxed);
+}
+
+template <class T>
+inline void TLockFreeStack<T>::PushNode(atomic<uint64_t>& list, uint32_t index)
+{
+  while (!TryPushNode(list, index)) {}
+}
+
+template <class T>
+inline typename TLockFreeStack<T>::TSlot& TLockFreeStack<T>::RandomSlot()
+{
+  static thread_local uint32_t seed = (uint32_t)(uintptr_t)&seed | 1;
+  seed ^= seed << 13;
+  seed ^= seed >> 17;
+  seed ^= seed << 5;
+  return slots[seed % EliminationSlots];
+}
+
+template <class T>
+inline bool TLockFreeStack<T>::EliminatePush(uint32_t index)
+{
+  TSlot& slot = RandomSlot();
+  uint64_t empty = slot.value.load(memory_order_relaxed);
+  if (Index(empty) != Null)
+    return false;
+  uint64_t offer = Tagged(empty, index);
+  if (!slot.value.compare_exchange_strong(empty, offer, memory_order_acq_rel, memory_order_relaxed))
+    return false;
+  // Ждем pop; он заменяет предложение пустым значением со следующим счетчиком
+  for (int i = 0; i < EliminationSpin; ++i)
+    if (slot.value.load(memory_order_acquire) != offer)
+      return true;
+  // Забираем предложение; не вышло - его только что принял pop
+  return !slot.value.compare_exchange_strong(offer, Tagged(offer, Null), memory_order_acq_rel, memory_order_acquire);
+}
+
+template <class T>
+inline bool TLockFreeStack<T>::EliminatePop(uint32_t& index)
+{
+  TSlot& slot = RandomSlot();
+  uint64_t offer = slot.value.load(memory_order_acquire);
+  if (Index(offer) == Null)
+    return false;
+  if (!slot.value.compare_exchange_strong(offer, Tagged(offer, Null), memory_order_acq_rel, memory_order_relaxed))
+    return false;
+  index = Index(offer);
+  return true;
+}
+
+template <class T>
+inline bool TLockFreeStack<T>::try_push(const T& element)
+{
+  uint32_t index = PopNode(freeList);
+  if (index == Null)
+    return false;
+  nodes[index].data = element;
+  while (!TryPushNode(head, index))
+    if (EliminatePush(index))
+      return true;
+  return true;
+}
+
+template <class T>
+inline void TLockFreeStack<T>::push(const T& element)
+{
+  if (!try_push(element))
+    throw "Stack is full";
+}
+
+template <class T>
+inline bool TLockFreeStack<T>::try_pop(T& element)
+{
+  uint64_t top = head.load(memory_order_acquire);
+  uint32_t index;
+  for (;;)
+  {
+    index = Index(top);
+    if (index == Null)
+      return false;
+    uint32_t next = nodes[index].next.load(memory_order_relaxed);
+    if (head.compare_exchange_strong(top, Tagged(top, next), memory_order_acq_rel, memory_order_acquire))
+      break;
+    if (EliminatePop(index))
+      break;
+    top = head.load(memory_order_acquire);
+  }
+  element = nodes[index].data;
+  PushNode(freeList, index);
+  return true;
+}
+
+template <class T>
+inline T TLockFreeStack<T>::pop()
+{
+  T element;
+  if (!try_pop(element))
+    throw "Stack is empty";
+  return element;
+}
+
+template <class T>
+inline bool TLockFreeStack<T>::IsEmpty() const
+{
+  return Index(head.load(memory_order_acquire)) == Null;
+}
+
+template <class T>
+inline bool TLockFreeStack<T>::IsFull() const
+{
+  return Index(freeList.load(memory_order_acquire)) == Null;
+}
\ No newline at end of file
@@ -0,0 +1,212 @@
+#include "MinKernel.h"
+
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+#define MIN_KERNEL_X86 1
+#include <immintrin.h>
+#endif
+
+// Скалярный цикл - эталон для всех остальных ядер
+template <class T>
+static T MinScalarLoop(T init, const T* data, size_t count)
+{
+  T acc = init;
+  for (size_t i = 0; i < count; ++i)
+    if (data[i] < acc)
+      acc = data[i];
+  return acc;
+}
+
+// Векторные ядра находят верное значение минимума, но при сведении дорожек
+// знак нуля может потеряться: возвращаем первый элемент, равный нулю, как скалярный цикл
+template <class T>
+static T FixZero(T result, T init, const T* data, size_t count)
+{
+  if (result != 0 || init == 0)
+    return result == 0 ? init : result;
+  for (size_t i = 0; i < count; ++i)
+    if (data[i] == 0)
+      return data[i];
+  return result;
+}
+
+#ifdef MIN_KERNEL_X86
+
+// Каждая дорожка аккумулятора начинается с init и обновляется как min(x, acc),
+// то есть повторяет скалярный цикл на своей подпоследовательности:
+// minps/minpd возвращают второй операнд, если первый не меньше или один из них NaN.
+
+__attribute__((target("sse4.1")))
+static int MinSseInt(int init, const int* data, size_t count)
+{
+  __m128i a0 = _mm_set1_epi32(init), a1 = a0;
+  size_t i = 0;
+  for (; i + 8 <= count; i += 8)
+  {
+    a0 = _mm_min_epi32(_mm_loadu_si128((const __m128i*)(data + i)), a0);
+    a1 = _mm_min_epi32(_mm_loadu_si128((const __m128i*)(data + i + 4)), a1);
+  }
+  alignas(16) int lanes[4];
+  _mm_store_si128((__m128i*)lanes, _mm_min_epi32(a0, a1));
+  int acc = MinScalarLoop(init, lanes, 4);
+  return MinScalarLoop(acc, data + i, count - i);
+}
+
+__attribute__((target("sse4.1")))
+static float MinSseFloat(float init, const float* data, size_t count)
+{
+  __m128 a0 = _mm_set1_ps(init), a1 = a0;
+  size_t i = 0;
+  for (; i + 8 <= count; i += 8)
+  {
+    a0 = _mm_min_ps(_mm_loadu_ps(data + i), a0);
+    a1 = _mm_min_ps(_mm_loadu_ps(data + i + 4), a1);
+  }
+  alignas(16) float lanes[8];
+  _mm_store_ps(lanes, a0);
+  _mm_store_ps(lanes + 4, a1);
+  float acc = MinScalarLoop(init, lanes, 8);
+  return MinScalarLoop(acc, data + i, count - i);
+}
+
+__attribute__((target("sse4.1")))
+static double MinSseDouble(double init, const double* data, size_t count)
+{
+  __m128d a0 = _mm_set1_pd(init), a1 = a0;
+  size_t i = 0;
+  for (; i + 4 <= count; i += 4)
+  {
+    a0 = _mm_min_pd(_mm_loadu_pd(data + i), a0);
+    a1 = _mm_min_pd(_mm_loadu_pd(data + i + 2), a1);
+  }
+  alignas(16) double lanes[4];
+  _mm_store_pd(lanes, a0);
+  _mm_store_pd(lanes + 2, a1);
+  double acc = MinScalarLoop(init, lanes, 4);
+  return MinScalarLoop(acc, data + i, count - i);
+}
+
+__attribute__((target("avx2")))
+static int MinAvx2Int(int init, const int* data, size_t count)
+{
+  __m256i a0 = _mm256_set1_epi32(init), a1 = a0;
+  size_t i = 0;
+  for (; i + 16 <= count; i += 16)
+  {
+    a0 = _mm256_min_epi32(_mm256_loadu_si256((const __m256i*)(data + i)), a0);
+    a1 = _mm256_min_epi32(_mm256_loadu_si256((const __m256i*)(data + i + 8)), a1);
+  }
+  alignas(32) int lanes[8];
+  _mm256_store_si256((__m256i*)lanes, _mm256_min_epi32(a0, a1));
+  int acc = MinScalarLoop(init, lanes, 8);
+  return MinScalarLoop(acc, data + i, count - i);
+}
+
+__attribute__((target("avx2")))
+static float MinAvx2Float(float init, const float* data, size_t count)
+{
+  __m256 a0 = _mm256_set1_ps(init), a1 = a0;
+  size_t i = 0;
+  for (; i + 16 <= count; i += 16)
+  {
+    a0 = _mm256_min_ps(_mm256_loadu_ps(data + i), a0);
+    a1 = _mm256_min_ps(_mm256_loadu_ps(data + i + 8), a1);
+  }
+  alignas(32) float lanes[16];
+  _mm256_store_ps(lanes, a0);
+  _mm256_store_ps(lanes + 8, a1);
+  float acc = MinScalarLoop(init, lanes, 16);
+  return MinScalarLoop(acc, data + i, count - i);
+}
+
+__attribute__((target("avx2")))
+static double MinAvx2Double(double init, const double* data, size_t count)
+{
+  __m256d a0 = _mm256_set1_pd(init), a1 = a0;
+  size_t i = 0;
+  for (; i + 8 <= count; i += 8)
+  {
+    a0 = _mm256_min_pd(_mm256_loadu_pd(data + i), a0);
+    a1 = _mm256_min_pd(_mm256_loadu_pd(data + i + 4), a1);
+  }
+  alignas(32) double lanes[8];
+  _mm256_store_pd(lanes, a0);
+  _mm256_store_pd(lanes + 4, a1);
+  double acc = MinScalarLoop(init, lanes, 8);
+  return MinScalarLoop(acc, data + i, count - i);
+}
+
+#endif
+
+TMinKernelLevel MinKernelLevel()
+{
+#ifdef MIN_KERNEL_X86
+  static const TMinKernelLevel level = __builtin_cpu_supports("avx2") ? MinAvx2
+    : __builtin_cpu_supports("sse4.1") ? MinSse : MinScalar;
+  return level;
+#else
+  return MinScalar;
+#endif
+}
+
+// Для коротких массивов векторное ядро не окупается
+const size_t MinKernelThreshold = 32;
+
+int MinKernel(int init, const int* data, size_t count, TMinKernelLevel level)
+{
+  if (level > MinKernelLevel())
+    level = MinKernelLevel();
+#ifdef MIN_KERNEL_X86
+  if (level == MinAvx2)
+    return MinAvx2Int(init, data, count);
+  if (level == MinSse)
+    return MinSseInt(init, data, count);
+#endif
+  return MinScalarLoop(init, data, count);
+}
+
+float MinKernel(float init, const float* data, size_t count, TMinKernelLevel level)
+{
+  if (level > MinKernelLevel())
+    level = MinKernelLevel();
+#ifdef MIN_KERNEL_X86
+  if (level == MinAvx2)
+    return FixZero(MinAvx2Float(init, data, count), init, data, count);
+  if (level == MinSse)
+    return FixZero(MinSseFloat(init, data, count), init, data, count);
+#endif
+  return MinScalarLoop(init, data, count);
+}
+
+double MinKernel(double init, const double* data, size_t count, TMinKernelLevel level)
+{
+  if (level > MinKernelLevel())
+    level = MinKernelLevel();
+#ifdef MIN_KERNEL_X86
+  if (level == MinAvx2)
+    return FixZero(MinAvx2Double(init, data, count), init, data, count);
+  if (level == MinSse)
+    return FixZero(MinSseDouble(init, data, count), init, data, count);
+#endif
+  return MinScalarLoop(init, data, count);
+}
+
+int MinKernel(int init, const int* data, size_t count)
+{
+  if (count < MinKernelThreshold)
+    return MinScalarLoop(init, data, count);
+  return MinKernel(init, data, count, MinAvx2);
+}
+
+float MinKernel(float init, const float* data, size_t count)
+{
+  if (count < MinKernelThreshold)
+    return MinScalarLoop(init, data, count);
+  return MinKernel(init, data, count, MinAvx2);
+}
+
+double MinKernel(double init, const double* data, size_t count)
+{
+  if (count < MinKernelThreshold)
+    return MinScalarLoop(init, data, count);
+  return MinKernel(init, data, count, MinAvx2);
+}
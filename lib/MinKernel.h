@@ -0,0 +1,29 @@
+#pragma once
+#include <cstddef>
+#include <type_traits>
+
+using namespace std;
+
+// Векторные ядра поиска минимума для int, float и double.
+// MinKernel(init, data, count) дает тот же результат, что цикл
+//   acc = init; for (x : data) if (x < acc) acc = x;
+// в том числе для NaN (NaN в init возвращается, остальные NaN пропускаются)
+// и для нулей (возвращается первый из равных нулю, со своим знаком).
+// Набор инструкций выбирается при первом вызове по возможностям процессора.
+
+enum TMinKernelLevel {MinScalar, MinSse, MinAvx2};
+
+// Лучший уровень, доступный на этом процессоре
+TMinKernelLevel MinKernelLevel();
+
+int MinKernel(int init, const int* data, size_t count);
+float MinKernel(float init, const float* data, size_t count);
+double MinKernel(double init, const double* data, size_t count);
+
+// Ядро заданного уровня (недоступный уровень понижается), для тестов и бенчмарков
+int MinKernel(int init, const int* data, size_t count, TMinKernelLevel level);
+float MinKernel(float init, const float* data, size_t count, TMinKernelLevel level);
+double MinKernel(double init, const double* data, size_t count, TMinKernelLevel level);
+
+template <class T>
+constexpr bool HasMinKernel = is_same_v<T, int> || is_same_v<T, float> || is_same_v<T, double>;
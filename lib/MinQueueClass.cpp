@@ -0,0 +1 @@
+#include "MinQueueClass.h"
\ No newline at end of file
@@ -0,0 +1,102 @@
+#pragma once
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include "QueueClass.h"
+
+using namespace std;
+
+// Очередь с минимумом за амортизированное O(1).
+// Кроме самих элементов хранится монотонная дека кандидатов в минимум
+// с их порядковыми номерами: новый элемент вытесняет с конца деки все,
+// что больше него, а pop убирает голову деки, только если уходит именно она.
+// Минимум понимается в смысле Compare, который должен быть строгим слабым порядком
+// (для вещественных - без NaN). TMaxQueue - тот же класс с greater<T>.
+template <class T, class Compare = less<T>>
+class TMinQueue
+{
+protected:
+  struct TCandidate
+  {
+    size_t index;
+    T value;
+  };
+
+  TQueue<T> values;
+  deque<TCandidate> candidates;
+  size_t pushed; // номер следующего добавляемого элемента
+  size_t popped; // номер следующего удаляемого элемента
+  Compare compare;
+public:
+  TMinQueue(size_t capacity_ = 16, Compare compare_ = Compare());
+
+  void push(const T& element);
+  T pop();
+  bool IsEmpty() const;
+  size_t Size() const;
+  T operator[](size_t index) const;
+
+  // Первый из наименьших элементов, как у TQueue::Min
+  T Min() const;
+};
+
+template <class T>
+class TMaxQueue : public TMinQueue<T, greater<T>>
+{
+public:
+  TMaxQueue(size_t capacity_ = 16) : TMinQueue<T, greater<T>>(capacity_) {}
+
+  T Max() const { return this->Min(); }
+};
+
+template <class T, class Compare>
+inline TMinQueue<T, Compare>::TMinQueue(size_t capacity_, Compare compare_)
+    : values(capacity_ < 2 ? 2 : capacity_, true), pushed(0), popped(0), compare(compare_) {}
+
+template <class T, class Compare>
+inline void TMinQueue<T, Compare>::push(const T& element)
+{
+  values.push(element);
+  // Равные не вытесняются, чтобы минимумом оставался более ранний
+  while (!candidates.empty() && compare(element, candidates.back().value))
+    candidates.pop_back();
+  candidates.push_back({pushed++, element});
+}
+
+template <class T, class Compare>
+inline T TMinQueue<T, Compare>::pop()
+{
+  T element = values.pop();
+  if (candidates.front().index == popped)
+    candidates.pop_front();
+  popped++;
+  return element;
+}
+
+template <class T, class Compare>
+inline bool TMinQueue<T, Compare>::IsEmpty() const
+{
+  return values.IsEmpty();
+}
+
+template <class T, class Compare>
+inline size_t TMinQueue<T, Compare>::Size() const
+{
+  return values.Size();
+}
+
+template <class T, class Compare>
+inline T TMinQueue<T, Compare>::operator[](size_t index) const
+{
+  if (index >= Size())
+    throw "Index out of range";
+  return values[index];
+}
+
+template <class T, class Compare>
+inline T TMinQueue<T, Compare>::Min() const
+{
+  if (IsEmpty())
+    throw "Queue is empty";
+  return candidates.front().value;
+}
\ No newline at end of file
@@ -0,0 +1 @@
+#include "MinStackClass.h"
\ No newline at end of file
@@ -0,0 +1,160 @@
+#pragma once
+#include <cstddef>
+#include "StackClass.h"
+
+using namespace std;
+
+// Стек с минимумом за O(1).
+// Рядом с каждым элементом хранится минимум всех элементов до него включительно,
+// поэтому push, pop и Min выполняются за O(1).
+// Память: второй стек того же размера, то есть еще sizeof(T) на каждый элемент.
+// Наследование закрытое: все изменения идут через методы TMinStack,
+// итераторов с доступом на запись нет. Оба стека берут память у одного аллокатора.
+template <class T, class Allocator = allocator<T>>
+class TMinStack : private TStack<T, Allocator>
+{
+protected:
+  using TBase = TStack<T, Allocator>;
+
+  TBase mins;
+
+  void Rebuild();
+public:
+  using TBase::GetCapacity;
+  using TBase::GetTop;
+  using TBase::GetAllocator;
+  using TBase::Size;
+  using TBase::operator[];
+  using TBase::IsEmpty;
+  using TBase::IsFull;
+
+  explicit TMinStack(const Allocator& alloc_ = Allocator());
+  TMinStack(size_t capacity_, const Allocator& alloc_ = Allocator());
+
+  void SetCapacity(size_t capacity_);
+  void SetTop(size_t top_);
+  void SetMemory(T* memory_);
+
+  void push(const T& element);
+  void push(T&& element);
+  // Элемент доступен только для чтения: изменение сломало бы минимумы
+  template <class... Args>
+  const T& emplace(Args&&... args);
+  T pop();
+  void pop_into(T& element);
+  const T& Peek() const;
+
+  // Тот же результат, что у TStack::Min, за O(1)
+  const T& Min() const;
+};
+
+template <class T, class Allocator>
+inline TMinStack<T, Allocator>::TMinStack(const Allocator& alloc_) : TBase(alloc_), mins(alloc_) {}
+
+template <class T, class Allocator>
+inline TMinStack<T, Allocator>::TMinStack(size_t capacity_, const Allocator& alloc_)
+    : TBase(capacity_, alloc_), mins(capacity_, alloc_) {}
+
+template <class T, class Allocator>
+inline void TMinStack<T, Allocator>::Rebuild()
+{
+  mins.SetTop(0);
+  for (size_t i = 0; i < this->top; ++i)
+  {
+    const T& element = this->memory[i];
+    if (mins.IsEmpty() || element < mins.Peek())
+      mins.push(element);
+    else
+      mins.push(mins.Peek());
+  }
+}
+
+template <class T, class Allocator>
+inline void TMinStack<T, Allocator>::SetCapacity(size_t capacity_)
+{
+  TBase::SetCapacity(capacity_);
+  mins.SetCapacity(capacity_);
+}
+
+template <class T, class Allocator>
+inline void TMinStack<T, Allocator>::SetTop(size_t top_)
+{
+  size_t oldTop = this->top;
+  TBase::SetTop(top_);
+  if (top_ <= oldTop)
+    mins.SetTop(top_);
+  else
+    Rebuild();
+}
+
+template <class T, class Allocator>
+inline void TMinStack<T, Allocator>::SetMemory(T* memory_)
+{
+  TBase::SetMemory(memory_);
+  Rebuild();
+}
+
+template <class T, class Allocator>
+inline void TMinStack<T, Allocator>::push(const T& element)
+{
+  emplace(element);
+}
+
+template <class T, class Allocator>
+inline void TMinStack<T, Allocator>::push(T&& element)
+{
+  emplace(std::move(element));
+}
+
+template <class T, class Allocator>
+template <class... Args>
+inline const T& TMinStack<T, Allocator>::emplace(Args&&... args)
+{
+  T& element = TBase::emplace(std::forward<Args>(args)...);
+  try
+  {
+    // Условие как в TStack::Min: меньший элемент заменяет минимум, равный - нет
+    if (mins.IsEmpty() || element < mins.Peek())
+      mins.push(element);
+    else
+      mins.push(mins.Peek());
+  }
+  catch (...)
+  {
+    // Элемент без минимума не остается
+    TBase::SetTop(this->top - 1);
+    throw;
+  }
+  return element;
+}
+
+template <class T, class Allocator>
+inline T TMinStack<T, Allocator>::pop()
+{
+  T element = TBase::pop();
+  mins.pop();
+  return element;
+}
+
+template <class T, class Allocator>
+inline void TMinStack<T, Allocator>::pop_into(T& element)
+{
+  TBase::pop_into(element);
+  mins.pop();
+}
+
+template <class T, class Allocator>
+inline const T& TMinStack<T, Allocator>::Peek() const
+{
+  if (IsEmpty())
+    throw "Stack is empty";
+  return this->memory[this->top - 1];
+}
+
+template <class T, class Allocator>
+inline const T& TMinStack<T, Allocator>::Min() const
+{
+  if (IsEmpty())
+    throw "Stack is empty";
+  return mins.GetMemory()[mins.Size() - 1];
+}
\ No newline at end of file
@@ -0,0 +1 @@
+#include "MpmcQueueClass.h"
\ No newline at end of file
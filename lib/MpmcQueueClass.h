@@ -0,0 +1,161 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <atomic>
+#include <bit>
+#include "SpscQueueClass.h"
+
+using namespace std;
+
+// Ограниченная очередь для многих производителей и многих потребителей без блокировок
+// (схема Д. Вьюкова). У каждой ячейки есть номер последовательности:
+// ячейка свободна для записи с номером pos, когда sequence == pos,
+// и готова к чтению, когда sequence == pos + 1.
+// Емкость округляется вверх до степени двойки, свободная ячейка не нужна.
+template <class T>
+class TMpmcQueue
+{
+protected:
+  struct TCell
+  {
+    atomic<size_t> sequence;
+    T data;
+  };
+
+  size_t capacity;
+  size_t mask;
+  TCell* cells;
+
+  alignas(CacheLine) atomic<size_t> finish; // следующая позиция записи
+  alignas(CacheLine) atomic<size_t> start;  // следующая позиция чтения
+  char padding[CacheLine - sizeof(atomic<size_t>)];
+public:
+  TMpmcQueue(size_t capacity_);
+  TMpmcQueue(const TMpmcQueue& other) = delete;
+  ~TMpmcQueue();
+
+  size_t GetCapacity() const;
+
+  bool try_push(const T& element);
+  void push(const T& element);
+  bool try_pop(T& element);
+  T pop();
+
+  // При одновременных операциях значения приблизительны
+  size_t Size() const;
+  bool IsEmpty() const;
+  bool IsFull() const;
+};
+
+template <class T>
+inline TMpmcQueue<T>::TMpmcQueue(size_t capacity_) : finish(0), start(0)
+{
+  if (capacity_ < 2)
+    throw "Queue capacity must be at least 2";
+  // Большая степень двойки не помещается в size_t
+  if (capacity_ > (SIZE_MAX >> 1) + 1)
+    throw "Queue capacity is too large";
+  capacity = bit_ceil(capacity_);
+  mask = capacity - 1;
+  cells = new TCell[capacity];
+  for (size_t i = 0; i < capacity; ++i)
+    cells[i].sequence.store(i, memory_order_relaxed);
+}
+
+template <class T>
+inline TMpmcQueue<T>::~TMpmcQueue()
+{
+  delete[] cells;
+}
+
+template <class T>
+inline size_t TMpmcQueue<T>::GetCapacity() const
+{
+  return capacity;
+}
+
+template <class T>
+inline bool TMpmcQueue<T>::try_push(const T& element)
+{
+  size_t pos = finish.load(memory_order_relaxed);
+  for (;;)
+  {
+    TCell& cell = cells[pos & mask];
+    size_t sequence = cell.sequence.load(memory_order_acquire);
+    ptrdiff_t diff = (ptrdiff_t)sequence - (ptrdiff_t)pos;
+    if (diff == 0)
+    {
+      // Ячейка свободна: занимаем позицию
+      if (finish.compare_exchange_weak(pos, pos + 1, memory_order_relaxed))
+      {
+        cell.data = element;
+        cell.sequence.store(pos + 1, memory_order_release);
+        return true;
+      }
+    } else if (diff < 0)
+      return false; // ячейку еще не освободил потребитель предыдущего круга
+    else
+      pos = finish.load(memory_order_relaxed);
+  }
+}
+
+template <class T>
+inline void TMpmcQueue<T>::push(const T& element)
+{
+  if (!try_push(element))
+    throw "Queue is full";
+}
+
+template <class T>
+inline bool TMpmcQueue<T>::try_pop(T& element)
+{
+  size_t pos = start.load(memory_order_relaxed);
+  for (;;)
+  {
+    TCell& cell = cells[pos & mask];
+    size_t sequence = cell.sequence.load(memory_order_acquire);
+    ptrdiff_t diff = (ptrdiff_t)sequence - (ptrdiff_t)(pos + 1);
+    if (diff == 0)
+    {
+      if (start.compare_exchange_weak(pos, pos + 1, memory_order_relaxed))
+      {
+        element = cell.data;
+        // Освобождаем ячейку для записи на следующем круге
+        cell.sequence.store(pos + capacity, memory_order_release);
+        return true;
+      }
+    } else if (diff < 0)
+      return false; // производитель еще не записал элемент
+    else
+      pos = start.load(memory_order_relaxed);
+  }
+}
+
+template <class T>
+inline T TMpmcQueue<T>::pop()
+{
+  T element;
+  if (!try_pop(element))
+    throw "Queue is empty";
+  return element;
+}
+
+template <class T>
+inline size_t TMpmcQueue<T>::Size() const
+{
+  size_t f = finish.load(memory_order_acquire);
+  size_t s = start.load(memory_order_acquire);
+  return f > s ? f - s : 0;
+}
+
+template <class T>
+inline bool TMpmcQueue<T>::IsEmpty() const
+{
+  return Size() == 0;
+}
+
+template <class T>
+inline bool TMpmcQueue<T>::IsFull() const
+{
+  return Size() >= capacity;
+}
\ No newline at end of file
@@ -0,0 +1 @@
+#include "ProgramClass.h"
\ No newline at end of file
@@ -0,0 +1,428 @@
+#pragma once
+#include <cstddef>
+#include <vector>
+#include <algorithm>
+#include <type_traits>
+#include <cmath>
+
+using namespace std;
+
+// Коды команд скомпилированной постфиксной формы
+enum TOpCode : unsigned char
+{
+  OpConst,
+  OpVar,
+  OpAdd,
+  OpSub,
+  OpMul,
+  OpDiv
+};
+
+// Команда: код операции, номер переменной и заранее разобранная константа
+template <class T>
+struct TInstruction
+{
+  TOpCode code;
+  unsigned slot;
+  T value;
+};
+
+template <class T>
+class TProgram
+{
+protected:
+  vector<TInstruction<T>> code;
+  size_t depth;   // максимальная глубина стека значений
+  size_t current; // глубина стека после последней команды
+  bool underflow; // оператору не хватило операндов
+  size_t variables; // число ячеек значений переменных
+
+  // Стек значений до этой глубины размещается в кадре Run()
+  static constexpr size_t LocalDepth = 64;
+  // Число строк, обрабатываемых одной командой в пакетном режиме
+  static constexpr size_t BlockRows = 256;
+
+  T Execute(const T* values, T* stack) const;
+  void Recount();
+  static bool IsAddNeutral(const T& value);
+  static bool IsSubNeutral(const T& value);
+  static bool IsOne(const T& value);
+  static T Apply(TOpCode op, const T& a, const T& b);
+  template <class Op>
+  static void BlockOperator(T* a, const T* b, size_t n, Op op);
+public:
+  // Наибольший номер ячейки переменной
+  static constexpr unsigned MaxSlot = 65535;
+
+  TProgram();
+
+  void Clear();
+  void PushConst(const T& value);
+  void PushVariable(unsigned slot);
+  void PushOperator(char op);
+  void PushOperator(TOpCode opCode);
+
+  size_t Size() const;
+  size_t GetDepth() const;
+  size_t GetVariables() const;
+  bool IsValid() const;
+  const TInstruction<T>& operator[](size_t index) const;
+
+  // Свертка констант и упрощения x*1, x+0, x*0; возвращает число удаленных команд
+  size_t Optimize();
+
+  // Вычисление без разбора строк и без выделения памяти
+  T Run(const T* values = nullptr) const;
+  // Пакетное вычисление: columns[k][row] - значение переменной k в строке row
+  void RunBatch(const T* const* columns, size_t columnCount, T* out, size_t rows) const;
+};
+
+template <class T>
+inline TProgram<T>::TProgram() : depth(0), current(0), underflow(false), variables(0) {}
+
+template <class T>
+inline void TProgram<T>::Clear()
+{
+  code.clear();
+  depth = 0;
+  current = 0;
+  underflow = false;
+  variables = 0;
+}
+
+template <class T>
+inline void TProgram<T>::PushConst(const T& value)
+{
+  code.push_back({OpConst, 0, value});
+  if (++current > depth)
+    depth = current;
+}
+
+template <class T>
+inline void TProgram<T>::PushVariable(unsigned slot)
+{
+  if (slot > MaxSlot)
+    throw "Slot index is too large";
+  code.push_back({OpVar, slot, T()});
+  if (slot >= variables)
+    variables = (size_t)slot + 1;
+  if (++current > depth)
+    depth = current;
+}
+
+template <class T>
+inline void TProgram<T>::PushOperator(char op)
+{
+  TOpCode opCode;
+  switch (op)
+  {
+    case '+':
+      opCode = OpAdd;
+      break;
+    case '-':
+      opCode = OpSub;
+      break;
+    case '*':
+      opCode = OpMul;
+      break;
+    case '/':
+      opCode = OpDiv;
+      break;
+    default:
+      throw "Unknown operator";
+  }
+  PushOperator(opCode);
+}
+
+template <class T>
+inline void TProgram<T>::PushOperator(TOpCode opCode)
+{
+  if (opCode == OpConst || opCode == OpVar)
+    throw "Unknown operator";
+  code.push_back({opCode, 0, T()});
+  if (current < 2)
+  {
+    underflow = true;
+    current = 1;
+  } else
+    current--;
+}
+
+template <class T>
+inline size_t TProgram<T>::Size() const
+{
+  return code.size();
+}
+
+template <class T>
+inline size_t TProgram<T>::GetDepth() const
+{
+  return depth;
+}
+
+template <class T>
+inline size_t TProgram<T>::GetVariables() const
+{
+  return variables;
+}
+
+template <class T>
+inline bool TProgram<T>::IsValid() const
+{
+  return !underflow && current > 0;
+}
+
+template <class T>
+inline const TInstruction<T>& TProgram<T>::operator[](size_t index) const
+{
+  if (index >= code.size())
+    throw "Index out of range";
+  return code[index];
+}
+
+template <class T>
+inline void TProgram<T>::Recount()
+{
+  depth = 0;
+  current = 0;
+  // Переменные могли исчезнуть при свертке
+  variables = 0;
+  for (const TInstruction<T>& ins : code)
+  {
+    if (ins.code == OpVar && ins.slot >= variables)
+      variables = (size_t)ins.slot + 1;
+    if (ins.code == OpConst || ins.code == OpVar)
+    {
+      if (++current > depth)
+        depth = current;
+    } else
+      current--;
+  }
+}
+
+// Для вещественных x + 0.0 превращает -0.0 в +0.0, нейтрален только -0.0
+template <class T>
+inline bool TProgram<T>::IsAddNeutral(const T& value)
+{
+  if (value != T())
+    return false;
+  if constexpr (is_floating_point_v<T>)
+    return signbit(value);
+  return true;
+}
+
+// И наоборот, x - (-0.0) превращает -0.0 в +0.0
+template <class T>
+inline bool TProgram<T>::IsSubNeutral(const T& value)
+{
+  if (value != T())
+    return false;
+  if constexpr (is_floating_point_v<T>)
+    return !signbit(value);
+  return true;
+}
+
+template <class T>
+inline bool TProgram<T>::IsOne(const T& value)
+{
+  return value == T(1);
+}
+
+template <class T>
+inline T TProgram<T>::Apply(TOpCode op, const T& a, const T& b)
+{
+  switch (op)
+  {
+    case OpAdd:
+      return a + b;
+    case OpSub:
+      return a - b;
+    case OpMul:
+      return a * b;
+    default:
+      return a / b;
+  }
+}
+
+template <class T>
+inline size_t TProgram<T>::Optimize()
+{
+  if (!IsValid())
+    return 0;
+
+  // Поддерево на стеке: начало его команд в out и значение, если оно константа
+  struct TOperand
+  {
+    size_t begin;
+    bool constant;
+    T value;
+  };
+  vector<TInstruction<T>> out;
+  vector<TOperand> operands;
+  out.reserve(code.size());
+
+  for (const TInstruction<T>& ins : code)
+  {
+    if (ins.code == OpConst || ins.code == OpVar)
+    {
+      operands.push_back({out.size(), ins.code == OpConst, ins.value});
+      out.push_back(ins);
+      continue;
+    }
+    TOperand b = operands.back();
+    operands.pop_back();
+    TOperand a = operands.back();
+    operands.pop_back();
+
+    if (a.constant && b.constant && !(is_integral_v<T> && ins.code == OpDiv && b.value == T()))
+    {
+      // Целочисленное деление на ноль оставляется до вычисления
+      T value = Apply(ins.code, a.value, b.value);
+      out.resize(a.begin);
+      out.push_back({OpConst, 0, value});
+      operands.push_back({a.begin, true, value});
+      continue;
+    }
+    if (b.constant && ((ins.code == OpAdd && IsAddNeutral(b.value)) ||
+                       (ins.code == OpSub && IsSubNeutral(b.value)) ||
+                       ((ins.code == OpMul || ins.code == OpDiv) && IsOne(b.value))))
+    {
+      // x+0, x-0, x*1, x/1
+      out.resize(b.begin);
+      operands.push_back(a);
+      continue;
+    }
+    if (a.constant && ((ins.code == OpAdd && IsAddNeutral(a.value)) ||
+                       (ins.code == OpMul && IsOne(a.value))))
+    {
+      // 0+x, 1*x
+      out.erase(out.begin() + a.begin);
+      operands.push_back({a.begin, false, T()});
+      continue;
+    }
+    if (is_integral_v<T> && ins.code == OpMul &&
+        ((a.constant && a.value == T()) || (b.constant && b.value == T())))
+    {
+      // x*0 и 0*x - только для целых: для вещественных x может быть inf или NaN
+      out.resize(a.begin);
+      out.push_back({OpConst, 0, T()});
+      operands.push_back({a.begin, true, T()});
+      continue;
+    }
+    out.push_back(ins);
+    operands.push_back({a.begin, false, T()});
+  }
+
+  size_t removed = code.size() - out.size();
+  code.swap(out);
+  Recount();
+  return removed;
+}
+
+template <class T>
+inline T TProgram<T>::Execute(const T* values, T* stack) const
+{
+  T* sp = stack;
+  for (const TInstruction<T>& ins : code)
+  {
+    switch (ins.code)
+    {
+      case OpConst:
+        *sp++ = ins.value;
+        break;
+      case OpVar:
+        *sp++ = values[ins.slot];
+        break;
+      case OpAdd:
+        sp[-2] = sp[-2] + sp[-1];
+        --sp;
+        break;
+      case OpSub:
+        sp[-2] = sp[-2] - sp[-1];
+        --sp;
+        break;
+      case OpMul:
+        sp[-2] = sp[-2] * sp[-1];
+        --sp;
+        break;
+      case OpDiv:
+        sp[-2] = sp[-2] / sp[-1];
+        --sp;
+        break;
+    }
+  }
+  return sp[-1];
+}
+
+template <class T>
+inline T TProgram<T>::Run(const T* values) const
+{
+  if (!IsValid())
+    throw "Stack is empty";
+  if (variables > 0 && values == nullptr)
+    throw "Variables are not bound";
+  if (depth <= LocalDepth)
+  {
+    T stack[LocalDepth];
+    return Execute(values, stack);
+  }
+  vector<T> stack(depth);
+  return Execute(values, stack.data());
+}
+
+template <class T>
+template <class Op>
+inline void TProgram<T>::BlockOperator(T* a, const T* b, size_t n, Op op)
+{
+  // Простой цикл без ветвлений - компилятор векторизует его
+  for (size_t i = 0; i < n; ++i)
+    a[i] = op(a[i], b[i]);
+}
+
+template <class T>
+inline void TProgram<T>::RunBatch(const T* const* columns, size_t columnCount, T* out, size_t rows) const
+{
+  if (!IsValid())
+    throw "Stack is empty";
+  if (columnCount < variables)
+    throw "Variables are not bound";
+
+  // Каждая ячейка стека - блок из BlockRows значений
+  vector<T> stack(depth * BlockRows);
+  for (size_t row = 0; row < rows; row += BlockRows)
+  {
+    size_t n = min(BlockRows, rows - row);
+    T* sp = stack.data();
+    for (const TInstruction<T>& ins : code)
+    {
+      switch (ins.code)
+      {
+        case OpConst:
+          fill(sp, sp + n, ins.value);
+          sp += BlockRows;
+          break;
+        case OpVar:
+          copy(columns[ins.slot] + row, columns[ins.slot] + row + n, sp);
+          sp += BlockRows;
+          break;
+        case OpAdd:
+          BlockOperator(sp - 2 * BlockRows, sp - BlockRows, n, [](T a, T b) { return a + b; });
+          sp -= BlockRows;
+          break;
+        case OpSub:
+          BlockOperator(sp - 2 * BlockRows, sp - BlockRows, n, [](T a, T b) { return a - b; });
+          sp -= BlockRows;
+          break;
+        case OpMul:
+          BlockOperator(sp - 2 * BlockRows, sp - BlockRows, n, [](T a, T b) { return a * b; });
+          sp -= BlockRows;
+          break;
+        case OpDiv:
+          BlockOperator(sp - 2 * BlockRows, sp - BlockRows, n, [](T a, T b) { return a / b; });
+          sp -= BlockRows;
+          break;
+      }
+    }
+    copy(sp - BlockRows, sp - BlockRows + n, out + row);
+  }
+}
\ No newline at end of file
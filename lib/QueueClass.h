@@ -1,20 +1,60 @@
 #pragma once
 #include <cstddef>
+#include <cstring>
+#include <type_traits>
+#include <utility>
+#include <span>
+#include <algorithm>
+#include <memory>
+#include <memory_resource>
+#include "MinKernel.h"
 
 using namespace std;
 
 
-template <class T>
+// Память берется у Allocator и не инициализируется: построены только ячейки
+// кольца [start, finish) и ячейки, выданные ReserveWrite.
+template <class T, class Allocator = allocator<T>>
 class TQueue
 {
 protected:
+    using TTraits = allocator_traits<Allocator>;
+
     size_t capacity;
     size_t start;
     size_t finish;
     T* memory;
+    bool growable; // при заполнении емкость удваивается вместо исключения
+    size_t reserved; // ячейки, выданные ReserveWrite и еще не подтвержденные
+    Allocator alloc;
+
+    T* Allocate(size_t count);
+    void Deallocate();
+    // Построение по умолчанию и разрушение count ячеек кольца начиная с from
+    void ConstructRing(size_t from, size_t count);
+    void DestroyRing(size_t from, size_t count);
+    // Разрушение выданных, но не подтвержденных ячеек
+    void ReleaseReserved();
+    // Перенос элементов по порядку в начало dst с разрушением старых
+    // (копирование, если перемещение может бросить). При исключении dst пуста,
+    // а очередь не изменена
+    void Relocate(T* dst);
+    void CopyIn(T* dst, const T* src, size_t count);
+    void MoveOut(T* dst, T* src, size_t count);
+    // Удвоение емкости, пока не поместятся еще count элементов
+    void Grow(size_t count = 1);
 public:
-    TQueue();
-    TQueue(size_t capacity_);
+    // Часть кольца: не больше двух непрерывных отрезков по порядку
+    struct TRegion
+    {
+        span<T> first;
+        span<T> second;
+        size_t Size() const { return first.size() + second.size(); }
+    };
+
+    explicit TQueue(const Allocator& alloc_ = Allocator());
+    TQueue(size_t capacity_, const Allocator& alloc_ = Allocator());
+    TQueue(size_t capacity_, bool growable_, const Allocator& alloc_ = Allocator());
     TQueue(const TQueue& other);
     TQueue(TQueue&& other);
     ~TQueue();
@@ -23,31 +63,51 @@ public:
     size_t GetStart() const;
     size_t GetFinish() const;
     T* GetMemory() const;
+    Allocator GetAllocator() const;
     void SetCapacity(size_t capacity_);
+    // Скрытые элементы разрушаются, открытые строятся по умолчанию
+    // (у тривиальных типов ячейки не трогаются)
     void SetStart(size_t start_);
     void SetFinish(size_t finish_);
+    // memory_ выделена через GetAllocator() на capacity элементов, [start, finish) построены
     void SetMemory(T* memory_);
+    bool IsGrowable() const;
+    void SetGrowable(bool growable_);
 
     // Размер очереди
     size_t Size() const;
 
-    bool operator==(const TQueue<T>& other) const;
-    bool operator!=(const TQueue<T>& other) const;
+    bool operator==(const TQueue<T, Allocator>& other) const;
+    bool operator!=(const TQueue<T, Allocator>& other) const;
     T operator[](size_t index) const;
 
     void push(const T& element);
     T pop();
+    // Пакетные операции: не больше двух копирований около конца буфера.
+    // Возвращают число перенесенных элементов.
+    size_t push_bulk(span<const T> elements);
+    size_t pop_bulk(span<T> elements);
+    size_t FreeSpace() const;
+
+    // Доступ без копирования: потребитель обрабатывает элементы на месте
+    // и подтверждает число прочитанных, производитель заполняет выданные ячейки
+    // и подтверждает число записанных. До подтверждения очередь не меняется:
+    // push, push_bulk и SetCapacity бросают исключение, pop читает только голову.
+    TRegion ReadRegion();
+    void CommitRead(size_t count);
+    TRegion ReserveWrite(size_t count);
+    void CommitWrite(size_t count);
     bool IsEmpty() const;
     bool IsFull() const;
 
     class TIterator
     {
     protected:
-        TQueue<T>& p;
+        TQueue<T, Allocator>& p;
         size_t current;
         size_t passed;
     public:
-        TIterator(TQueue<T> &queue, size_t start_pos, size_t passed_count);
+        TIterator(TQueue<T, Allocator> &queue, size_t start_pos, size_t passed_count);
         T& operator*();
         TIterator& operator++();
         TIterator operator++(int);
@@ -64,137 +124,268 @@ public:
 
 };
 
-template <class T>
-inline TQueue<T>::TQueue() : capacity(0), start(0), finish(0), memory(new T[capacity]) {}
+template <class T, class Allocator>
+inline TQueue<T, Allocator>::TQueue(const Allocator& alloc_) : TQueue(0, alloc_) {}
 
-template <class T>
-inline TQueue<T>::TQueue(size_t capacity_)
+template <class T, class Allocator>
+inline TQueue<T, Allocator>::TQueue(size_t capacity_, const Allocator& alloc_) : alloc(alloc_)
 {
     capacity = capacity_;
     start = 0;
     finish = 0;
-    if (capacity_ > 0)
-        memory = new T[capacity_];
-    else
-        memory = nullptr;
+    growable = false;
+    reserved = 0;
+    memory = Allocate(capacity_);
 }
 
-template <class T>
-inline TQueue<T>::TQueue(const TQueue& other)
+template <class T, class Allocator>
+inline TQueue<T, Allocator>::TQueue(size_t capacity_, bool growable_, const Allocator& alloc_) : TQueue(capacity_, alloc_)
+{
+    growable = growable_;
+}
+
+template <class T, class Allocator>
+inline TQueue<T, Allocator>::TQueue(const TQueue& other)
+    : alloc(TTraits::select_on_container_copy_construction(other.alloc))
 {
     capacity = other.capacity;
     start = other.start;
-    finish = other.finish;
-    if (other.capacity > 0)
-      {
-      memory = new T[other.capacity];
-      if (other.memory)
-      {
-        for (size_t i = 0; i < capacity; ++i)
-          memory[i] = other.memory[i];
-      }
+    finish = other.start;
+    growable = other.growable;
+    reserved = 0;
+    memory = Allocate(capacity);
+    // Элементы остаются в тех же ячейках кольца
+    for (size_t i = 0; i < other.Size(); ++i)
+    {
+        TTraits::construct(alloc, memory + finish, other.memory[finish]);
+        finish = (finish + 1) % capacity;
     }
-    else memory = nullptr;
 }
 
-template <class T>
-inline TQueue<T>::TQueue(TQueue&& other)
+template <class T, class Allocator>
+inline TQueue<T, Allocator>::TQueue(TQueue&& other) : alloc(std::move(other.alloc))
 {
   capacity = other.capacity;
   start = other.start;
   finish = other.finish;
   memory = other.memory;
+  growable = other.growable;
+  reserved = other.reserved;
 
   other.capacity = 0;
   other.start = 0;
   other.finish = 0;
   other.memory = nullptr;
+  other.reserved = 0;
 }
 
-template <class T>
-inline TQueue<T>::~TQueue()
+template <class T, class Allocator>
+inline TQueue<T, Allocator>::~TQueue()
+{
+  ReleaseReserved();
+  DestroyRing(start, Size());
+  Deallocate();
+}
+
+template <class T, class Allocator>
+inline T* TQueue<T, Allocator>::Allocate(size_t count)
+{
+  return count > 0 ? TTraits::allocate(alloc, count) : nullptr;
+}
+
+template <class T, class Allocator>
+inline void TQueue<T, Allocator>::Deallocate()
+{
+  if (memory)
+    TTraits::deallocate(alloc, memory, capacity);
+}
+
+template <class T, class Allocator>
+inline void TQueue<T, Allocator>::ConstructRing(size_t from, size_t count)
+{
+  if constexpr (!is_trivially_default_constructible_v<T> || !is_trivially_destructible_v<T>)
+    for (size_t i = 0; i < count; ++i)
+      TTraits::construct(alloc, memory + (from + i) % capacity);
+}
+
+template <class T, class Allocator>
+inline void TQueue<T, Allocator>::DestroyRing(size_t from, size_t count)
+{
+  if constexpr (!is_trivially_destructible_v<T>)
+    for (size_t i = 0; i < count; ++i)
+      TTraits::destroy(alloc, memory + (from + i) % capacity);
+}
+
+template <class T, class Allocator>
+inline void TQueue<T, Allocator>::ReleaseReserved()
 {
-  delete[] memory;
+  DestroyRing(finish, reserved);
+  reserved = 0;
 }
 
 // геттеры и сеттеры
 
-template <class T>
-inline size_t TQueue<T>::GetCapacity() const
+template <class T, class Allocator>
+inline size_t TQueue<T, Allocator>::GetCapacity() const
 {
   return capacity;
 }
 
-template <class T>
-inline size_t TQueue<T>::GetStart() const
+template <class T, class Allocator>
+inline size_t TQueue<T, Allocator>::GetStart() const
 {
   return start;
 }
 
-template <class T>
-inline size_t TQueue<T>::GetFinish() const
+template <class T, class Allocator>
+inline size_t TQueue<T, Allocator>::GetFinish() const
 {
   return finish;
 }
 
-template <class T>
-inline T* TQueue<T>::GetMemory() const
+template <class T, class Allocator>
+inline T* TQueue<T, Allocator>::GetMemory() const
 {
   return memory;
 }
 
-template <class T>
-inline void TQueue<T>::SetCapacity(size_t capacity_)
+template <class T, class Allocator>
+inline Allocator TQueue<T, Allocator>::GetAllocator() const
 {
-  if (capacity_ != capacity) {
-      T* newMemory = nullptr;
-      if (capacity_ > 0)
-          newMemory = new T[capacity_];
+  return alloc;
+}
 
-      if (memory && newMemory)
-      {
-          size_t copySize = capacity_;
-          if (capacity_ > capacity)
-              copySize = capacity;
+template <class T, class Allocator>
+inline void TQueue<T, Allocator>::SetCapacity(size_t capacity_)
+{
+  if (capacity_ == capacity)
+    return;
+  // Одна ячейка всегда остается свободной
+  if (capacity_ > 0 && capacity_ <= Size())
+    throw "New capacity cannot be smaller";
+  if (capacity_ == 0 && !IsEmpty())
+    throw "New capacity cannot be smaller";
+  if (reserved > 0)
+    throw "Write region is reserved";
+
+  size_t size = Size();
+  T* newMemory = Allocate(capacity_);
+  if (newMemory && memory)
+  {
+    try
+    {
+      Relocate(newMemory);
+    }
+    catch (...)
+    {
+      TTraits::deallocate(alloc, newMemory, capacity_);
+      throw;
+    }
+  }
+  Deallocate();
+  memory = newMemory;
+  capacity = capacity_;
+  // Элементы лежат подряд с нулевой ячейки
+  start = 0;
+  finish = size;
+}
 
-          for (size_t i = 0; i < copySize; ++i)
-              newMemory[i] = memory[i];
+template <class T, class Allocator>
+inline void TQueue<T, Allocator>::Relocate(T* dst)
+{
+  // Занятая часть кольца - не больше двух непрерывных отрезков
+  size_t first = start <= finish ? finish - start : capacity - start;
+  size_t second = start <= finish ? 0 : finish;
+  if constexpr (is_trivially_copyable_v<T>)
+  {
+      if (first > 0)
+          memcpy(dst, memory + start, first * sizeof(T));
+      if (second > 0)
+          memcpy(dst + first, memory, second * sizeof(T));
+  } else
+  {
+      size_t built = 0;
+      try
+      {
+          for (; built < first + second; ++built)
+          {
+              T& element = built < first ? memory[start + built] : memory[built - first];
+              TTraits::construct(alloc, dst + built, std::move_if_noexcept(element));
+          }
+      }
+      catch (...)
+      {
+          while (built-- > 0)
+              TTraits::destroy(alloc, dst + built);
+          throw;
       }
-      delete[] memory;
-      memory = newMemory;
-      capacity = capacity_;
-      if (start >= capacity)
-          start = 0;
-      if (finish >= capacity)
-          finish = 0;
+      DestroyRing(start, first + second);
   }
 }
 
-template <class T>
-inline void TQueue<T>::SetStart(size_t start_)
+template <class T, class Allocator>
+inline void TQueue<T, Allocator>::Grow(size_t count)
 {
-    if (start_ < capacity)
-        start = start_;
+  size_t newCapacity = capacity < 2 ? 2 : capacity * 2;
+  while (newCapacity - 1 < Size() + count)
+      newCapacity *= 2;
+  SetCapacity(newCapacity);
 }
 
-template <class T>
-inline void TQueue<T>::SetFinish(size_t finish_)
+template <class T, class Allocator>
+inline void TQueue<T, Allocator>::SetStart(size_t start_)
 {
-    if (finish_ < capacity)
-        finish = finish_;
+    if (start_ >= capacity)
+        return;
+    // Старое и новое кольцо кончаются на finish: одно содержит другое
+    size_t size = (finish + capacity - start_) % capacity;
+    if (size <= Size())
+        DestroyRing(start, Size() - size);
+    else
+        ConstructRing(start_, size - Size());
+    start = start_;
 }
 
-template <class T>
-inline void TQueue<T>::SetMemory(T* memory_)
+template <class T, class Allocator>
+inline void TQueue<T, Allocator>::SetFinish(size_t finish_)
+{
+    if (finish_ >= capacity)
+        return;
+    // Старое и новое кольцо начинаются со start: одно содержит другое
+    ReleaseReserved();
+    size_t size = (finish_ + capacity - start) % capacity;
+    if (size <= Size())
+        DestroyRing(finish_, Size() - size);
+    else
+        ConstructRing(finish, size - Size());
+    finish = finish_;
+}
+
+template <class T, class Allocator>
+inline void TQueue<T, Allocator>::SetMemory(T* memory_)
 {
+    ReleaseReserved();
+    DestroyRing(start, Size());
+    Deallocate();
     memory = memory_;
-    delete[] memory_;
 }
 
 
 
-template <class T>
-inline size_t TQueue<T>::Size() const
+template <class T, class Allocator>
+inline bool TQueue<T, Allocator>::IsGrowable() const
+{
+    return growable;
+}
+
+template <class T, class Allocator>
+inline void TQueue<T, Allocator>::SetGrowable(bool growable_)
+{
+    growable = growable_;
+}
+
+template <class T, class Allocator>
+inline size_t TQueue<T, Allocator>::Size() const
 {
     if (start <= finish) {
         return finish - start;
@@ -204,21 +395,21 @@ inline size_t TQueue<T>::Size() const
 }
 // Операторы
 
-template <class T>
-inline T TQueue<T>::operator[](size_t index) const
+template <class T, class Allocator>
+inline T TQueue<T, Allocator>::operator[](size_t index) const
 {
     if (memory == nullptr)
         throw "Queue memory is not allocated";
 
-    if (index >= capacity)
+    if (index >= Size())
         throw "Index out of range";
 
     size_t resIndex = (start + index) % capacity;
     return memory[resIndex];
 }
 
-template <class T>
-inline bool TQueue<T>::operator==(const TQueue<T>& other) const
+template <class T, class Allocator>
+inline bool TQueue<T, Allocator>::operator==(const TQueue<T, Allocator>& other) const
 {
     if (this == &other)
         return true;
@@ -229,65 +420,198 @@ inline bool TQueue<T>::operator==(const TQueue<T>& other) const
     if (memory == other.memory)
         return true;
 
-    for (size_t i = 0; i < capacity; ++i) {
+    // Сравниваются только построенные элементы
+    for (size_t i = start; i != finish; i = (i + 1) % capacity) {
         if (memory[i] != other.memory[i])
             return false;
     }
     return true;
 }
 
-template <class T>
-inline bool TQueue<T>::operator!=(const TQueue<T>& other) const
+template <class T, class Allocator>
+inline bool TQueue<T, Allocator>::operator!=(const TQueue<T, Allocator>& other) const
 {
     return !(*this == other);
 }
 
 // паша поп
 
-template <class T>
-inline void TQueue<T>::push(const T& element)
+template <class T, class Allocator>
+inline void TQueue<T, Allocator>::push(const T& element)
 {
-    if (IsFull()) throw "Queue is full";
-    memory[finish] = element;
+    if (reserved > 0)
+        throw "Write region is reserved";
+    if (IsFull())
+    {
+        if (!growable) throw "Queue is full";
+        // element может ссылаться на старый буфер
+        T copy(element);
+        Grow();
+        TTraits::construct(alloc, memory + finish, std::move(copy));
+        finish = (finish + 1) % capacity;
+        return;
+    }
+    TTraits::construct(alloc, memory + finish, element);
     finish = (finish + 1) % capacity;
 }
 
-template <class T>
-inline T TQueue<T>::pop()
+template <class T, class Allocator>
+inline T TQueue<T, Allocator>::pop()
 {
     if (IsEmpty()) throw "Queue is empty";
-    T element = memory[start];
+    T element = std::move(memory[start]);
+    TTraits::destroy(alloc, memory + start);
     start = (start + 1) % capacity;
     return element;
 }
 
-template <class T>
-inline bool TQueue<T>::IsEmpty() const
+template <class T, class Allocator>
+inline void TQueue<T, Allocator>::CopyIn(T* dst, const T* src, size_t count)
+{
+    if constexpr (is_trivially_copyable_v<T>)
+    {
+        if (count > 0)
+            memcpy(dst, src, count * sizeof(T));
+    } else
+        for (size_t i = 0; i < count; ++i)
+            TTraits::construct(alloc, dst + i, src[i]);
+}
+
+template <class T, class Allocator>
+inline void TQueue<T, Allocator>::MoveOut(T* dst, T* src, size_t count)
+{
+    if constexpr (is_trivially_copyable_v<T>)
+    {
+        if (count > 0)
+            memcpy(dst, src, count * sizeof(T));
+    } else
+    {
+        std::move(src, src + count, dst);
+        for (size_t i = 0; i < count; ++i)
+            TTraits::destroy(alloc, src + i);
+    }
+}
+
+template <class T, class Allocator>
+inline size_t TQueue<T, Allocator>::FreeSpace() const
+{
+    // Одна ячейка всегда свободна
+    return capacity == 0 ? 0 : capacity - 1 - Size();
+}
+
+template <class T, class Allocator>
+inline size_t TQueue<T, Allocator>::push_bulk(span<const T> elements)
+{
+    if (reserved > 0)
+        throw "Write region is reserved";
+    size_t count = elements.size();
+    if (count > FreeSpace() && growable)
+        Grow(count);
+    count = min(count, FreeSpace());
+    size_t first = min(count, capacity - finish);
+    CopyIn(memory + finish, elements.data(), first);
+    CopyIn(memory, elements.data() + first, count - first);
+    if (count > 0)
+        finish = (finish + count) % capacity;
+    return count;
+}
+
+template <class T, class Allocator>
+inline size_t TQueue<T, Allocator>::pop_bulk(span<T> elements)
+{
+    size_t count = min(elements.size(), Size());
+    size_t first = min(count, capacity - start);
+    MoveOut(elements.data(), memory + start, first);
+    MoveOut(elements.data() + first, memory, count - first);
+    if (count > 0)
+        start = (start + count) % capacity;
+    return count;
+}
+
+template <class T, class Allocator>
+inline typename TQueue<T, Allocator>::TRegion TQueue<T, Allocator>::ReadRegion()
+{
+    size_t count = Size();
+    size_t first = min(count, capacity - start);
+    TRegion region;
+    if (count > 0)
+    {
+        region.first = span<T>(memory + start, first);
+        region.second = span<T>(memory, count - first);
+    }
+    return region;
+}
+
+template <class T, class Allocator>
+inline void TQueue<T, Allocator>::CommitRead(size_t count)
+{
+    if (count > Size())
+        throw "Commit exceeds region";
+    DestroyRing(start, count);
+    if (count > 0)
+        start = (start + count) % capacity;
+}
+
+template <class T, class Allocator>
+inline typename TQueue<T, Allocator>::TRegion TQueue<T, Allocator>::ReserveWrite(size_t count)
+{
+    // Новая выдача заменяет прежнюю неподтвержденную
+    ReleaseReserved();
+    if (count > FreeSpace() && growable)
+        Grow(count);
+    count = min(count, FreeSpace());
+    size_t first = min(count, capacity - finish);
+    TRegion region;
+    if (count > 0)
+    {
+        region.first = span<T>(memory + finish, first);
+        region.second = span<T>(memory, count - first);
+    }
+    // Выданные ячейки строятся, чтобы в них можно было присваивать
+    ConstructRing(finish, count);
+    reserved = count;
+    return region;
+}
+
+template <class T, class Allocator>
+inline void TQueue<T, Allocator>::CommitWrite(size_t count)
+{
+    if (count > reserved || count > FreeSpace())
+        throw "Commit exceeds region";
+    // Неиспользованные ячейки разрушаются
+    DestroyRing((finish + count) % max<size_t>(capacity, 1), reserved - count);
+    if (count > 0)
+        finish = (finish + count) % capacity;
+    reserved = 0;
+}
+
+template <class T, class Allocator>
+inline bool TQueue<T, Allocator>::IsEmpty() const
 {
     return start == finish;
 }
 
-template <class T>
-inline bool TQueue<T>::IsFull() const
+template <class T, class Allocator>
+inline bool TQueue<T, Allocator>::IsFull() const
 {
-    return (finish + 1) % capacity == start;
+    return capacity == 0 || (finish + 1) % capacity == start;
 }
 
 // итератор
 
-template <class T>
-inline TQueue<T>::TIterator::TIterator(TQueue<T>& queue, size_t start_pos, size_t passed_count)
+template <class T, class Allocator>
+inline TQueue<T, Allocator>::TIterator::TIterator(TQueue<T, Allocator>& queue, size_t start_pos, size_t passed_count)
     : p(queue), current(start_pos), passed(passed_count) {}
 
 
-template <class T>
-inline T& TQueue<T>::TIterator::operator*()
+template <class T, class Allocator>
+inline T& TQueue<T, Allocator>::TIterator::operator*()
 {
     return p.memory[current];
 }
 
-template <class T>
-inline typename TQueue<T>::TIterator& TQueue<T>::TIterator::operator++()
+template <class T, class Allocator>
+inline typename TQueue<T, Allocator>::TIterator& TQueue<T, Allocator>::TIterator::operator++()
 {
     if (passed >= p.Size()) {
         throw "Iterator out of range";
@@ -297,54 +621,65 @@ inline typename TQueue<T>::TIterator& TQueue<T>::TIterator::operator++()
     return *this;
 }
 
-template <class T>
-inline typename TQueue<T>::TIterator TQueue<T>::TIterator::operator++(int)
+template <class T, class Allocator>
+inline typename TQueue<T, Allocator>::TIterator TQueue<T, Allocator>::TIterator::operator++(int)
 {
     TIterator temp = *this;
     ++(*this);
     return temp;
 }
 
-template <class T>
-inline bool TQueue<T>::TIterator::operator==(const TIterator& other) const
+template <class T, class Allocator>
+inline bool TQueue<T, Allocator>::TIterator::operator==(const TIterator& other) const
 {
     return &p == &other.p && current == other.current && passed == other.passed;
 }
 
-template <class T>
-inline bool TQueue<T>::TIterator::operator!=(const TIterator& other) const
+template <class T, class Allocator>
+inline bool TQueue<T, Allocator>::TIterator::operator!=(const TIterator& other) const
 {
     return !(*this == other);
 }
 
-template <class T>
-inline typename TQueue<T>::TIterator TQueue<T>::begin()
+template <class T, class Allocator>
+inline typename TQueue<T, Allocator>::TIterator TQueue<T, Allocator>::begin()
 {
     return TIterator(*this, start, 0);
 }
 
-template <class T>
-inline typename TQueue<T>::TIterator TQueue<T>::end()
+template <class T, class Allocator>
+inline typename TQueue<T, Allocator>::TIterator TQueue<T, Allocator>::end()
 {
     return TIterator(*this, (start + Size()) % capacity, Size());
 }
 
 
-template <class T>
-inline T TQueue<T>::Min() const
+template <class T, class Allocator>
+inline T TQueue<T, Allocator>::Min() const
 {
   if (start == finish)
     throw "Queue is empty";
   // Инициализация минимального элемента первым элементом очереди
   T minElement = memory[start];
-  size_t current = start;
-  // Обход всех элементов очереди
-  while (current != finish)
+  // Кольцо - не больше двух непрерывных отрезков, обходим их по порядку без деления
+  size_t firstEnd = finish > start ? finish : capacity;
+  if constexpr (HasMinKernel<T>)
   {
-    if (memory[current] < minElement)
-      minElement = memory[current];
-    current = (current + 1) % capacity;
+    minElement = MinKernel(minElement, memory + start + 1, firstEnd - start - 1);
+    if (finish < start)
+      minElement = MinKernel(minElement, memory, finish);
+    return minElement;
   }
+  for (size_t i = start + 1; i < firstEnd; ++i)
+    if (memory[i] < minElement)
+      minElement = memory[i];
+  if (finish < start)
+    for (size_t i = 0; i < finish; ++i)
+      if (memory[i] < minElement)
+        minElement = memory[i];
   return minElement;
 }
 
+// Очередь в памяти std::pmr::memory_resource (арена, пул потока)
+template <class T>
+using TPmrQueue = TQueue<T, pmr::polymorphic_allocator<T>>;
\ No newline at end of file
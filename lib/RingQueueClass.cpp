@@ -0,0 +1 @@
+#include "RingQueueClass.h"
\ No newline at end of file
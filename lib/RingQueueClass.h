@@ -0,0 +1,206 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <bit>
+
+using namespace std;
+
+// Очередь на кольцевом буфере с емкостью - степенью двойки.
+// start и finish - свободно растущие счетчики, ячейка равна счетчику по маске,
+// поэтому push и pop обходятся без деления, а занятыми могут быть все ячейки:
+// пустая очередь - finish == start, полная - finish - start == capacity.
+template <class T>
+class TRingQueue
+{
+protected:
+    size_t capacity;
+    size_t mask;
+    size_t start;
+    size_t finish;
+    T* memory;
+public:
+    // Емкость округляется вверх до степени двойки
+    TRingQueue(size_t capacity_ = 16);
+    TRingQueue(const TRingQueue& other);
+    TRingQueue(TRingQueue&& other);
+    ~TRingQueue();
+
+    size_t GetCapacity() const;
+    size_t Size() const;
+
+    T operator[](size_t index) const;
+
+    void push(const T& element);
+    T pop();
+    bool IsEmpty() const;
+    bool IsFull() const;
+
+    class TIterator
+    {
+    protected:
+        TRingQueue<T>& p;
+        size_t current; // значение счетчика
+    public:
+        TIterator(TRingQueue<T>& queue, size_t position);
+        T& operator*();
+        TIterator& operator++();
+        TIterator operator++(int);
+        bool operator==(const TIterator& other) const;
+        bool operator!=(const TIterator& other) const;
+    };
+
+    TIterator begin();
+    TIterator end();
+
+    T Min() const;
+};
+
+template <class T>
+inline TRingQueue<T>::TRingQueue(size_t capacity_) : start(0), finish(0)
+{
+    if (capacity_ == 0)
+        throw "Queue capacity must be positive";
+    // Большая степень двойки не помещается в size_t
+    if (capacity_ > (SIZE_MAX >> 1) + 1)
+        throw "Queue capacity is too large";
+    capacity = bit_ceil(capacity_);
+    mask = capacity - 1;
+    memory = new T[capacity];
+}
+
+template <class T>
+inline TRingQueue<T>::TRingQueue(const TRingQueue& other)
+    : capacity(other.capacity), mask(other.mask), start(other.start), finish(other.finish), memory(new T[capacity])
+{
+    for (size_t i = start; i != finish; ++i)
+        memory[i & mask] = other.memory[i & mask];
+}
+
+template <class T>
+inline TRingQueue<T>::TRingQueue(TRingQueue&& other)
+    : capacity(other.capacity), mask(other.mask), start(other.start), finish(other.finish), memory(other.memory)
+{
+    other.memory = nullptr;
+    other.capacity = 0;
+    other.mask = 0;
+    other.start = 0;
+    other.finish = 0;
+}
+
+template <class T>
+inline TRingQueue<T>::~TRingQueue()
+{
+    delete[] memory;
+}
+
+template <class T>
+inline size_t TRingQueue<T>::GetCapacity() const
+{
+    return capacity;
+}
+
+template <class T>
+inline size_t TRingQueue<T>::Size() const
+{
+    // Верно и после переполнения счетчиков
+    return finish - start;
+}
+
+template <class T>
+inline T TRingQueue<T>::operator[](size_t index) const
+{
+    if (index >= Size())
+        throw "Index out of range";
+    return memory[(start + index) & mask];
+}
+
+template <class T>
+inline void TRingQueue<T>::push(const T& element)
+{
+    if (IsFull()) throw "Queue is full";
+    memory[finish & mask] = element;
+    finish++;
+}
+
+template <class T>
+inline T TRingQueue<T>::pop()
+{
+    if (IsEmpty()) throw "Queue is empty";
+    return memory[start++ & mask];
+}
+
+template <class T>
+inline bool TRingQueue<T>::IsEmpty() const
+{
+    return finish == start;
+}
+
+template <class T>
+inline bool TRingQueue<T>::IsFull() const
+{
+    return finish - start == capacity;
+}
+
+template <class T>
+inline TRingQueue<T>::TIterator::TIterator(TRingQueue<T>& queue, size_t position) : p(queue), current(position) {}
+
+template <class T>
+inline T& TRingQueue<T>::TIterator::operator*()
+{
+    return p.memory[current & p.mask];
+}
+
+template <class T>
+inline typename TRingQueue<T>::TIterator& TRingQueue<T>::TIterator::operator++()
+{
+    if (current == p.finish)
+        throw "Iterator out of range";
+    current++;
+    return *this;
+}
+
+template <class T>
+inline typename TRingQueue<T>::TIterator TRingQueue<T>::TIterator::operator++(int)
+{
+    TIterator temp = *this;
+    ++(*this);
+    return temp;
+}
+
+template <class T>
+inline bool TRingQueue<T>::TIterator::operator==(const TIterator& other) const
+{
+    return &p == &other.p && current == other.current;
+}
+
+template <class T>
+inline bool TRingQueue<T>::TIterator::operator!=(const TIterator& other) const
+{
+    return !(*this == other);
+}
+
+template <class T>
+inline typename TRingQueue<T>::TIterator TRingQueue<T>::begin()
+{
+    return TIterator(*this, start);
+}
+
+template <class T>
+inline typename TRingQueue<T>::TIterator TRingQueue<T>::end()
+{
+    return TIterator(*this, finish);
+}
+
+template <class T>
+inline T TRingQueue<T>::Min() const
+{
+    if (IsEmpty())
+        throw "Queue is empty";
+    T minElement = memory[start & mask];
+    for (size_t i = start + 1; i != finish; ++i)
+    {
+        if (memory[i & mask] < minElement)
+            minElement = memory[i & mask];
+    }
+    return minElement;
+}
\ No newline at end of file
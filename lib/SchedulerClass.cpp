@@ -0,0 +1 @@
+#include "SchedulerClass.h"
\ No newline at end of file
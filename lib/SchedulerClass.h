@@ -0,0 +1,196 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "WorkStealingDequeClass.h"
+
+using namespace std;
+
+// Пул потоков с перехватом работы.
+// ParallelFor делит [0, count) на куски по grain, каждый поток кладет свою долю кусков
+// в свою деку, выполняет их с нижнего конца, а закончив - перехватывает куски
+// у случайных соседей. Вызывающий поток работает как поток 0.
+// ParallelFor нельзя вызывать одновременно из разных потоков.
+// Исключение из body запоминается (первое из брошенных), оставшиеся куски снимаются
+// без выполнения, и после завершения всех потоков исключение бросается в вызывающем.
+class TScheduler
+{
+protected:
+  using TInvoke = void (*)(void* body, size_t begin, size_t end);
+
+  size_t threads;
+  vector<unique_ptr<TWorkStealingDeque<size_t>>> deques;
+  vector<thread> workers;
+
+  // Текущее задание
+  TInvoke invoke;
+  void* body;
+  size_t count;
+  size_t grain;
+  atomic<size_t> remaining; // невыполненные куски
+  atomic<size_t> active;    // потоки, еще не вышедшие из задания
+  atomic<bool> failed;      // body бросил исключение
+  exception_ptr error;      // первое исключение, под lock
+
+  mutex lock;
+  condition_variable wake;
+  uint64_t generation; // номер задания, под lock
+  bool stopping;
+
+  void Work(size_t index);
+  void WorkerLoop(size_t index);
+  void Run(TInvoke invoke_, void* body_, size_t count_, size_t grain_);
+public:
+  // 0 - по числу ядер
+  TScheduler(size_t threads_ = 0);
+  TScheduler(const TScheduler& other) = delete;
+  ~TScheduler();
+
+  size_t GetThreads() const;
+
+  // body(i) для каждого i из [0, count); возвращает управление, когда все вызовы завершены
+  template <class F>
+  void ParallelFor(size_t count_, size_t grain_, F body_);
+};
+
+inline TScheduler::TScheduler(size_t threads_)
+    : threads(threads_), invoke(nullptr), body(nullptr), count(0), grain(1),
+      remaining(0), active(0), failed(false), generation(0), stopping(false)
+{
+  if (threads == 0)
+    threads = thread::hardware_concurrency() > 0 ? thread::hardware_concurrency() : 1;
+  for (size_t i = 0; i < threads; ++i)
+    deques.emplace_back(new TWorkStealingDeque<size_t>(256));
+  for (size_t i = 1; i < threads; ++i)
+    workers.emplace_back(&TScheduler::WorkerLoop, this, i);
+}
+
+inline TScheduler::~TScheduler()
+{
+  {
+    lock_guard<mutex> guard(lock);
+    stopping = true;
+  }
+  wake.notify_all();
+  for (thread& worker : workers)
+    worker.join();
+}
+
+inline size_t TScheduler::GetThreads() const
+{
+  return threads;
+}
+
+inline void TScheduler::Work(size_t index)
+{
+  TWorkStealingDeque<size_t>& own = *deques[index];
+  size_t chunks = (count + grain - 1) / grain;
+  // Своя доля кладется с конца, чтобы снимать куски по возрастанию
+  for (size_t chunk = chunks; chunk-- > 0;)
+    if (chunk % threads == index)
+      own.push(chunk);
+
+  uint32_t seed = (uint32_t)index * 2654435761u + 1;
+  size_t chunk;
+  while (remaining.load(memory_order_acquire) > 0)
+  {
+    bool found = own.try_pop(chunk);
+    if (!found && threads > 1)
+    {
+      seed ^= seed << 13;
+      seed ^= seed >> 17;
+      seed ^= seed << 5;
+      size_t victim = seed % threads;
+      if (victim != index)
+        found = deques[victim]->try_steal(chunk);
+    }
+    if (!found)
+    {
+      this_thread::yield();
+      continue;
+    }
+    if (!failed.load(memory_order_relaxed))
+    {
+      size_t begin = chunk * grain;
+      try
+      {
+        invoke(body, begin, min(begin + grain, count));
+      }
+      catch (...)
+      {
+        lock_guard<mutex> guard(lock);
+        if (!error)
+          error = current_exception();
+        failed.store(true, memory_order_relaxed);
+      }
+    }
+    remaining.fetch_sub(1, memory_order_acq_rel);
+  }
+  active.fetch_sub(1, memory_order_acq_rel);
+}
+
+inline void TScheduler::WorkerLoop(size_t index)
+{
+  uint64_t seen = 0;
+  for (;;)
+  {
+    {
+      unique_lock<mutex> guard(lock);
+      wake.wait(guard, [&] { return stopping || generation != seen; });
+      if (stopping)
+        return;
+      seen = generation;
+    }
+    Work(index);
+  }
+}
+
+inline void TScheduler::Run(TInvoke invoke_, void* body_, size_t count_, size_t grain_)
+{
+  if (count_ == 0)
+    return;
+  invoke = invoke_;
+  body = body_;
+  count = count_;
+  grain = grain_ > 0 ? grain_ : 1;
+  remaining.store((count + grain - 1) / grain, memory_order_relaxed);
+  active.store(threads, memory_order_relaxed);
+  failed.store(false, memory_order_relaxed);
+  {
+    lock_guard<mutex> guard(lock);
+    generation++;
+  }
+  wake.notify_all();
+  Work(0);
+  // Следующее задание начинается, когда все потоки вышли из текущего
+  while (active.load(memory_order_acquire) > 0)
+    this_thread::yield();
+  if (failed.load(memory_order_relaxed))
+  {
+    exception_ptr thrown;
+    {
+      lock_guard<mutex> guard(lock);
+      thrown = error;
+      error = nullptr;
+    }
+    rethrow_exception(thrown);
+  }
+}
+
+template <class F>
+inline void TScheduler::ParallelFor(size_t count_, size_t grain_, F body_)
+{
+  TInvoke call = [](void* f, size_t begin, size_t end)
+  {
+    for (size_t i = begin; i < end; ++i)
+      (*static_cast<F*>(f))(i);
+  };
+  Run(call, &body_, count_, grain_);
+}
\ No newline at end of file
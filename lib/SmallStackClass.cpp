@@ -0,0 +1 @@
+#include "SmallStackClass.h"
\ No newline at end of file
@@ -0,0 +1,260 @@
+#pragma once
+#include <cstddef>
+#include <cstring>
+#include <memory>
+#include <type_traits>
+#include <utility>
+
+using namespace std;
+
+// Стек с N элементами внутри объекта.
+// Пока элементов не больше N, память в куче не выделяется;
+// дальше элементы переносятся в память Allocator и емкость удваивается.
+// Подходит для коротких временных стеков: скобки и операции одной формулы.
+template <class T, size_t N = 16, class Allocator = allocator<T>>
+class TSmallStack
+{
+  static_assert(N > 0, "Inline capacity must be positive");
+protected:
+  using TTraits = allocator_traits<Allocator>;
+
+  size_t capacity;
+  size_t top;
+  T* memory; // встроенный буфер или куча
+  Allocator alloc;
+  alignas(T) unsigned char buffer[N * sizeof(T)];
+
+  T* Inline();
+  void Destroy();
+  // Построение в dst count элементов из src перемещением (копированием, если
+  // перемещение может бросить); src не разрушается. При исключении dst пуста
+  void MoveElements(T* src, T* dst, size_t count);
+public:
+  explicit TSmallStack(const Allocator& alloc_ = Allocator());
+  TSmallStack(const TSmallStack& other);
+  TSmallStack(TSmallStack&& other);
+  ~TSmallStack();
+
+  size_t GetCapacity() const;
+  size_t Size() const;
+  // Элементы лежат во встроенном буфере
+  bool IsInline() const;
+
+  T operator[](size_t index) const;
+
+  void push(const T& element);
+  void push(T&& element);
+  template <class... Args>
+  T& emplace(Args&&... args);
+  T pop();
+  void pop_into(T& element);
+  T Peek() const;
+  bool IsEmpty() const;
+  bool IsFull() const;
+  // Удаление всех элементов; память в куче остается за стеком
+  void Clear();
+};
+
+template <class T, size_t N, class Allocator>
+inline T* TSmallStack<T, N, Allocator>::Inline()
+{
+  return reinterpret_cast<T*>(buffer);
+}
+
+template <class T, size_t N, class Allocator>
+inline TSmallStack<T, N, Allocator>::TSmallStack(const Allocator& alloc_)
+    : capacity(N), top(0), memory(Inline()), alloc(alloc_) {}
+
+template <class T, size_t N, class Allocator>
+inline TSmallStack<T, N, Allocator>::TSmallStack(const TSmallStack& other)
+    : capacity(N), top(0), memory(Inline()),
+      alloc(TTraits::select_on_container_copy_construction(other.alloc))
+{
+  if (other.top > N)
+  {
+    capacity = other.capacity;
+    memory = TTraits::allocate(alloc, capacity);
+  }
+  for (; top < other.top; ++top)
+    TTraits::construct(alloc, memory + top, other.memory[top]);
+}
+
+template <class T, size_t N, class Allocator>
+inline TSmallStack<T, N, Allocator>::TSmallStack(TSmallStack&& other)
+    : capacity(N), top(0), memory(Inline()), alloc(other.alloc)
+{
+  // Аллокатор копируется: other остается пригодным для работы
+  if (other.IsInline())
+  {
+    // Встроенный буфер не передать: элементы переносятся
+    MoveElements(other.memory, memory, other.top);
+    top = other.top;
+    other.Destroy();
+  } else
+  {
+    capacity = other.capacity;
+    top = other.top;
+    memory = other.memory;
+    other.memory = other.Inline();
+    other.capacity = N;
+  }
+  other.top = 0;
+}
+
+template <class T, size_t N, class Allocator>
+inline TSmallStack<T, N, Allocator>::~TSmallStack()
+{
+  Destroy();
+  if (!IsInline())
+    TTraits::deallocate(alloc, memory, capacity);
+}
+
+template <class T, size_t N, class Allocator>
+inline void TSmallStack<T, N, Allocator>::Destroy()
+{
+  if constexpr (!is_trivially_destructible_v<T>)
+    for (size_t i = 0; i < top; ++i)
+      TTraits::destroy(alloc, memory + i);
+}
+
+template <class T, size_t N, class Allocator>
+inline void TSmallStack<T, N, Allocator>::MoveElements(T* src, T* dst, size_t count)
+{
+  if constexpr (is_trivially_copyable_v<T>)
+  {
+    if (count > 0)
+      memcpy(dst, src, count * sizeof(T));
+  } else
+  {
+    size_t built = 0;
+    try
+    {
+      for (; built < count; ++built)
+        TTraits::construct(alloc, dst + built, std::move_if_noexcept(src[built]));
+    }
+    catch (...)
+    {
+      while (built-- > 0)
+        TTraits::destroy(alloc, dst + built);
+      throw;
+    }
+  }
+}
+
+template <class T, size_t N, class Allocator>
+inline size_t TSmallStack<T, N, Allocator>::GetCapacity() const
+{
+  return capacity;
+}
+
+template <class T, size_t N, class Allocator>
+inline size_t TSmallStack<T, N, Allocator>::Size() const
+{
+  return top;
+}
+
+template <class T, size_t N, class Allocator>
+inline bool TSmallStack<T, N, Allocator>::IsInline() const
+{
+  return memory == reinterpret_cast<const T*>(buffer);
+}
+
+template <class T, size_t N, class Allocator>
+inline T TSmallStack<T, N, Allocator>::operator[](size_t index) const
+{
+  if (index >= top)
+    throw "Index out of range";
+  return memory[index];
+}
+
+template <class T, size_t N, class Allocator>
+inline void TSmallStack<T, N, Allocator>::push(const T& element)
+{
+  emplace(element);
+}
+
+template <class T, size_t N, class Allocator>
+inline void TSmallStack<T, N, Allocator>::push(T&& element)
+{
+  emplace(std::move(element));
+}
+
+template <class T, size_t N, class Allocator>
+template <class... Args>
+inline T& TSmallStack<T, N, Allocator>::emplace(Args&&... args)
+{
+  if (IsFull())
+  {
+    size_t newCapacity = capacity * 2;
+    T* newMemory = TTraits::allocate(alloc, newCapacity);
+    bool built = false;
+    try
+    {
+      // аргументы могут ссылаться на элементы стека: строим до переноса
+      TTraits::construct(alloc, newMemory + top, std::forward<Args>(args)...);
+      built = true;
+      MoveElements(memory, newMemory, top);
+    }
+    catch (...)
+    {
+      // Стек остается прежним, новая память возвращается
+      if (built)
+        TTraits::destroy(alloc, newMemory + top);
+      TTraits::deallocate(alloc, newMemory, newCapacity);
+      throw;
+    }
+    Destroy();
+    if (!IsInline())
+      TTraits::deallocate(alloc, memory, capacity);
+    memory = newMemory;
+    capacity = newCapacity;
+  } else
+    TTraits::construct(alloc, memory + top, std::forward<Args>(args)...);
+  return memory[top++];
+}
+
+template <class T, size_t N, class Allocator>
+inline T TSmallStack<T, N, Allocator>::pop()
+{
+  if (IsEmpty())
+    throw "Stack is empty";
+  T element = std::move(memory[--top]);
+  TTraits::destroy(alloc, memory + top);
+  return element;
+}
+
+template <class T, size_t N, class Allocator>
+inline void TSmallStack<T, N, Allocator>::pop_into(T& element)
+{
+  if (IsEmpty())
+    throw "Stack is empty";
+  element = std::move(memory[--top]);
+  TTraits::destroy(alloc, memory + top);
+}
+
+template <class T, size_t N, class Allocator>
+inline T TSmallStack<T, N, Allocator>::Peek() const
+{
+  if (IsEmpty())
+    throw "Stack is empty";
+  return memory[top - 1];
+}
+
+template <class T, size_t N, class Allocator>
+inline bool TSmallStack<T, N, Allocator>::IsEmpty() const
+{
+  return top == 0;
+}
+
+template <class T, size_t N, class Allocator>
+inline bool TSmallStack<T, N, Allocator>::IsFull() const
+{
+  return top == capacity;
+}
+
+template <class T, size_t N, class Allocator>
+inline void TSmallStack<T, N, Allocator>::Clear()
+{
+  Destroy();
+  top = 0;
+}
\ No newline at end of file
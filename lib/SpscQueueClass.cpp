@@ -0,0 +1 @@
+#include "SpscQueueClass.h"
\ No newline at end of file
@@ -0,0 +1,148 @@
+#pragma once
+#include <cstddef>
+#include <atomic>
+
+using namespace std;
+
+// Размер строки кэша, по которому разносятся индексы
+const size_t CacheLine = 64;
+
+// Очередь для одного производителя и одного потребителя без блокировок.
+// Кольцевой буфер как у TQueue: один элемент всегда свободен, чтобы отличать полную очередь от пустой.
+// start меняет только потребитель, finish - только производитель; каждый держит копию чужого индекса
+// и перечитывает его, лишь когда копии не хватает. push и pop не ждут друг друга.
+template <class T>
+class TSpscQueue
+{
+protected:
+  size_t capacity;
+  T* memory;
+
+  // Данные потребителя
+  alignas(CacheLine) atomic<size_t> start;
+  size_t cachedFinish;
+
+  // Данные производителя
+  alignas(CacheLine) atomic<size_t> finish;
+  size_t cachedStart;
+
+  char padding[CacheLine - sizeof(atomic<size_t>) - sizeof(size_t)];
+
+  size_t Next(size_t index) const;
+public:
+  TSpscQueue(size_t capacity_);
+  TSpscQueue(const TSpscQueue& other) = delete;
+  ~TSpscQueue();
+
+  size_t GetCapacity() const;
+
+  // Вызываются только из потока производителя
+  bool try_push(const T& element);
+  void push(const T& element);
+
+  // Вызываются только из потока потребителя
+  bool try_pop(T& element);
+  T pop();
+
+  // Точные значения только при отсутствии одновременных операций
+  size_t Size() const;
+  bool IsEmpty() const;
+  bool IsFull() const;
+};
+
+template <class T>
+inline TSpscQueue<T>::TSpscQueue(size_t capacity_)
+    : capacity(capacity_), memory(nullptr), start(0), cachedFinish(0), finish(0), cachedStart(0)
+{
+  if (capacity_ < 2)
+    throw "Queue capacity must be at least 2";
+  memory = new T[capacity_];
+}
+
+template <class T>
+inline TSpscQueue<T>::~TSpscQueue()
+{
+  delete[] memory;
+}
+
+template <class T>
+inline size_t TSpscQueue<T>::GetCapacity() const
+{
+  return capacity;
+}
+
+template <class T>
+inline size_t TSpscQueue<T>::Next(size_t index) const
+{
+  // Сравнение вместо деления по модулю
+  return index + 1 == capacity ? 0 : index + 1;
+}
+
+template <class T>
+inline bool TSpscQueue<T>::try_push(const T& element)
+{
+  size_t current = finish.load(memory_order_relaxed);
+  size_t next = Next(current);
+  if (next == cachedStart)
+  {
+    cachedStart = start.load(memory_order_acquire);
+    if (next == cachedStart)
+      return false;
+  }
+  memory[current] = element;
+  finish.store(next, memory_order_release);
+  return true;
+}
+
+template <class T>
+inline void TSpscQueue<T>::push(const T& element)
+{
+  if (!try_push(element))
+    throw "Queue is full";
+}
+
+template <class T>
+inline bool TSpscQueue<T>::try_pop(T& element)
+{
+  size_t current = start.load(memory_order_relaxed);
+  if (current == cachedFinish)
+  {
+    cachedFinish = finish.load(memory_order_acquire);
+    if (current == cachedFinish)
+      return false;
+  }
+  element = memory[current];
+  start.store(Next(current), memory_order_release);
+  return true;
+}
+
+template <class T>
+inline T TSpscQueue<T>::pop()
+{
+  T element;
+  if (!try_pop(element))
+    throw "Queue is empty";
+  return element;
+}
+
+template <class T>
+inline size_t TSpscQueue<T>::Size() const
+{
+  size_t s = start.load(memory_order_acquire);
+  size_t f = finish.load(memory_order_acquire);
+  if (s <= f)
+    return f - s;
+  return capacity - s + f;
+}
+
+template <class T>
+inline bool TSpscQueue<T>::IsEmpty() const
+{
+  return start.load(memory_order_acquire) == finish.load(memory_order_acquire);
+}
+
+template <class T>
+inline bool TSpscQueue<T>::IsFull() const
+{
+  return Next(finish.load(memory_order_acquire)) == start.load(memory_order_acquire);
+}
\ No newline at end of file
@@ -1,18 +1,38 @@
 #pragma once
 #include <cstddef>
+#include <cstring>
+#include <memory>
+#include <memory_resource>
+#include <type_traits>
+#include <utility>
+#include "MinKernel.h"
 
 using namespace std;
 
-template <class T>
+// Память берется у Allocator и не инициализируется:
+// элементы строятся в push и разрушаются в pop, построены ровно ячейки [0, top).
+template <class T, class Allocator = allocator<T>>
 class TStack
 {
 protected:
+  using TTraits = allocator_traits<Allocator>;
+
   size_t capacity;
   size_t top;
   T* memory;
+  Allocator alloc;
+
+  T* Allocate(size_t count);
+  void Deallocate(T* memory_, size_t count);
+  // Разрушение элементов [first, last)
+  void Destroy(size_t first, size_t last);
+  // Перенос построенных элементов в новую память с разрушением старых:
+  // memcpy для тривиально копируемых T, иначе перемещение (копирование, если
+  // перемещение может бросить). При исключении dst пуста, а стек не изменен
+  void Relocate(T* dst);
 public:
-  TStack();
-  TStack(size_t capacity_);
+  explicit TStack(const Allocator& alloc_ = Allocator());
+  TStack(size_t capacity_, const Allocator& alloc_ = Allocator());
   TStack(const TStack& other);
   TStack(TStack&& other);
   ~TStack();
@@ -20,32 +40,42 @@ public:
   size_t GetCapacity() const;
   size_t GetTop() const;
   T* GetMemory() const;
+  Allocator GetAllocator() const;
 
 
   void SetCapacity(size_t capacity_);
+  // Скрытые элементы разрушаются, открытые строятся по умолчанию
+  // (у тривиальных типов ячейки не трогаются)
   void SetTop(size_t top_);
+  // memory_ выделена через GetAllocator() на capacity элементов, первые top построены
   void SetMemory(T* memory_);
 
   // Размер стека
   size_t Size() const;
 
-  bool operator==(const TStack<T>& other) const;
-  bool operator!=(const TStack<T>& other) const;
+  bool operator==(const TStack<T, Allocator>& other) const;
+  bool operator!=(const TStack<T, Allocator>& other) const;
   T operator[](size_t index) const;
 
   void push(const T& element); // Добавление элемента
+  void push(T&& element);
+  // Построение элемента на месте из аргументов конструктора T
+  template <class... Args>
+  T& emplace(Args&&... args);
   T pop(); // Удаление и возврат верхнего элемента
+  void pop_into(T& element); // Перемещение верхнего элемента в element
+  T Peek() const; // Верхний элемент без удаления
   bool IsEmpty() const;
   bool IsFull() const;
 
   class TIterator
   {
   protected:
-    TStack<T>& p;
+    TStack<T, Allocator>& p;
     size_t current;
     size_t passed;
   public:
-    TIterator(TStack<T> &stack, size_t start_pos, size_t passed_count);
+    TIterator(TStack<T, Allocator> &stack, size_t start_pos, size_t passed_count);
     T& operator*();
     TIterator& operator++();
     TIterator operator++(int);
@@ -60,91 +90,166 @@ public:
   T Min() const;
 };
 
-template <class T>
-inline TStack<T>::TStack() : capacity(10), top(0), memory(new T[capacity]) {}
+template <class T, class Allocator>
+inline TStack<T, Allocator>::TStack(const Allocator& alloc_) : TStack(10, alloc_) {}
 
-template <class T>
-inline TStack<T>::TStack(size_t capacity_) : capacity(capacity_), top(0), memory(new T[capacity]) {}
+template <class T, class Allocator>
+inline TStack<T, Allocator>::TStack(size_t capacity_, const Allocator& alloc_)
+    : capacity(capacity_), top(0), memory(nullptr), alloc(alloc_)
+{
+    memory = Allocate(capacity);
+}
 
-template <class T>
-inline TStack<T>::TStack(const TStack& other) : capacity(other.capacity), top(other.top), memory(new T[capacity])
+template <class T, class Allocator>
+inline TStack<T, Allocator>::TStack(const TStack& other)
+    : capacity(other.capacity), top(0), memory(nullptr),
+      alloc(TTraits::select_on_container_copy_construction(other.alloc))
 {
-    for (size_t i = 0; i < top; ++i)
-        memory[i] = other.memory[i];
+    memory = Allocate(capacity);
+    for (; top < other.top; ++top)
+        TTraits::construct(alloc, memory + top, other.memory[top]);
 }
 
-template <class T>
-inline TStack<T>::TStack(TStack&& other) : capacity(other.capacity), top(other.top), memory(other.memory)
+template <class T, class Allocator>
+inline TStack<T, Allocator>::TStack(TStack&& other)
+    : capacity(other.capacity), top(other.top), memory(other.memory), alloc(std::move(other.alloc))
 {
     other.memory = nullptr;
     other.capacity = 0;
     other.top = 0;
 }
 
-template <class T>
-inline TStack<T>::~TStack()
+template <class T, class Allocator>
+inline TStack<T, Allocator>::~TStack()
+{
+    Destroy(0, top);
+    Deallocate(memory, capacity);
+}
+
+template <class T, class Allocator>
+inline T* TStack<T, Allocator>::Allocate(size_t count)
+{
+    return count > 0 ? TTraits::allocate(alloc, count) : nullptr;
+}
+
+template <class T, class Allocator>
+inline void TStack<T, Allocator>::Deallocate(T* memory_, size_t count)
 {
-    delete[] memory;
+    if (memory_)
+        TTraits::deallocate(alloc, memory_, count);
+}
+
+template <class T, class Allocator>
+inline void TStack<T, Allocator>::Destroy(size_t first, size_t last)
+{
+    if constexpr (!is_trivially_destructible_v<T>)
+        for (size_t i = first; i < last; ++i)
+            TTraits::destroy(alloc, memory + i);
+}
+
+template <class T, class Allocator>
+inline void TStack<T, Allocator>::Relocate(T* dst)
+{
+    if constexpr (is_trivially_copyable_v<T>)
+    {
+        if (top > 0)
+            memcpy(dst, memory, top * sizeof(T));
+    } else
+    {
+        size_t i = 0;
+        try
+        {
+            for (; i < top; ++i)
+                TTraits::construct(alloc, dst + i, std::move_if_noexcept(memory[i]));
+        }
+        catch (...)
+        {
+            while (i-- > 0)
+                TTraits::destroy(alloc, dst + i);
+            throw;
+        }
+        Destroy(0, top);
+    }
 }
 
 // геттеры и сеттеры
-template <class T>
-inline size_t TStack<T>::GetCapacity() const
+template <class T, class Allocator>
+inline size_t TStack<T, Allocator>::GetCapacity() const
 {
     return capacity;
 }
 
-template <class T>
-inline size_t TStack<T>::GetTop() const
+template <class T, class Allocator>
+inline size_t TStack<T, Allocator>::GetTop() const
 {
     return top;
 }
 
-template <class T>
-inline T* TStack<T>::GetMemory() const
+template <class T, class Allocator>
+inline T* TStack<T, Allocator>::GetMemory() const
 {
     return memory;
 }
 
-template <class T>
-inline void TStack<T>::SetCapacity(size_t capacity_)
+template <class T, class Allocator>
+inline Allocator TStack<T, Allocator>::GetAllocator() const
+{
+    return alloc;
+}
+
+template <class T, class Allocator>
+inline void TStack<T, Allocator>::SetCapacity(size_t capacity_)
 {
     if (capacity_ < top)
         throw "New capacity cannot be smaller";
-    T* newMemory = new T[capacity_];
-    for (size_t i = 0; i < top; ++i)
-        newMemory[i] = memory[i];
-
-    delete[] memory;
+    T* newMemory = Allocate(capacity_);
+    try
+    {
+        Relocate(newMemory);
+    }
+    catch (...)
+    {
+        Deallocate(newMemory, capacity_);
+        throw;
+    }
+    Deallocate(memory, capacity);
     memory = newMemory;
     capacity = capacity_;
 }
 
-template <class T>
-inline void TStack<T>::SetTop(size_t top_)
+template <class T, class Allocator>
+inline void TStack<T, Allocator>::SetTop(size_t top_)
 {
     if (top_ > capacity)
         throw "Top index exceeds capacity";
+    if (top_ < top)
+        Destroy(top_, top);
+    else if constexpr (!is_trivially_default_constructible_v<T> || !is_trivially_destructible_v<T>)
+    {
+        for (size_t i = top; i < top_; ++i)
+            TTraits::construct(alloc, memory + i);
+    }
     top = top_;
 }
 
-template <class T>
-inline void TStack<T>::SetMemory(T* memory_)
+template <class T, class Allocator>
+inline void TStack<T, Allocator>::SetMemory(T* memory_)
 {
-    delete[] memory;
+    Destroy(0, top);
+    Deallocate(memory, capacity);
     memory = memory_;
 }
 
-template <class T>
-inline size_t TStack<T>::Size() const
+template <class T, class Allocator>
+inline size_t TStack<T, Allocator>::Size() const
 {
     return top;
 }
 
 // операторы
 
-template <class T>
-inline bool TStack<T>::operator==(const TStack<T>& other) const
+template <class T, class Allocator>
+inline bool TStack<T, Allocator>::operator==(const TStack<T, Allocator>& other) const
 {
     if (top != other.top)
         return false;
@@ -157,14 +262,14 @@ inline bool TStack<T>::operator==(const TStack<T>& other) const
     return true;
 }
 
-template <class T>
-inline bool TStack<T>::operator!=(const TStack<T>& other) const
+template <class T, class Allocator>
+inline bool TStack<T, Allocator>::operator!=(const TStack<T, Allocator>& other) const
 {
     return !(*this == other);
 }
 
-template <class T>
-inline T TStack<T>::operator[](size_t index) const
+template <class T, class Allocator>
+inline T TStack<T, Allocator>::operator[](size_t index) const
 {
     if (index >= top)
         throw "Index out of range";
@@ -173,110 +278,154 @@ inline T TStack<T>::operator[](size_t index) const
 
 // паша поп
 
-template <class T>
-inline void TStack<T>::push(const T& element)
+template <class T, class Allocator>
+inline void TStack<T, Allocator>::push(const T& element)
+{
+    emplace(element);
+}
+
+template <class T, class Allocator>
+inline void TStack<T, Allocator>::push(T&& element)
+{
+    emplace(std::move(element));
+}
+
+template <class T, class Allocator>
+template <class... Args>
+inline T& TStack<T, Allocator>::emplace(Args&&... args)
 {
     if (IsFull()) {
-        if (capacity == 0) {
-            capacity = 10;
-            memory = new T[capacity];
-        } else {
-            size_t new_capacity = capacity * 2;
-            T* new_memory = new T[new_capacity];
-
-            for (size_t i = 0; i < top; ++i) {
-                new_memory[i] = memory[i];
-            }
-
-            delete[] memory;
-            memory = new_memory;
-            capacity = new_capacity;
+        size_t new_capacity = capacity == 0 ? 10 : capacity * 2;
+        T* new_memory = Allocate(new_capacity);
+        bool built = false;
+        try
+        {
+            // аргументы могут ссылаться на элементы в старой памяти: строим до переноса
+            TTraits::construct(alloc, new_memory + top, std::forward<Args>(args)...);
+            built = true;
+            Relocate(new_memory);
         }
-    }
-    memory[top] = element;
-    top++;
+        catch (...)
+        {
+            // Стек остается прежним, новая память возвращается
+            if (built)
+                TTraits::destroy(alloc, new_memory + top);
+            Deallocate(new_memory, new_capacity);
+            throw;
+        }
+        Deallocate(memory, capacity);
+        memory = new_memory;
+        capacity = new_capacity;
+    } else
+        TTraits::construct(alloc, memory + top, std::forward<Args>(args)...);
+    return memory[top++];
 }
 
-template <class T>
-inline T TStack<T>::pop()
+template <class T, class Allocator>
+inline T TStack<T, Allocator>::pop()
 {
     if (IsEmpty())
         throw "Stack is empty";
 
-    return memory[--top];
+    T element = std::move(memory[--top]);
+    TTraits::destroy(alloc, memory + top);
+    return element;
 }
 
-template <class T>
-inline bool TStack<T>::IsEmpty() const
+template <class T, class Allocator>
+inline void TStack<T, Allocator>::pop_into(T& element)
+{
+    if (IsEmpty())
+        throw "Stack is empty";
+
+    element = std::move(memory[--top]);
+    TTraits::destroy(alloc, memory + top);
+}
+
+template <class T, class Allocator>
+inline T TStack<T, Allocator>::Peek() const
+{
+    if (IsEmpty())
+        throw "Stack is empty";
+
+    return memory[top - 1];
+}
+
+template <class T, class Allocator>
+inline bool TStack<T, Allocator>::IsEmpty() const
 {
     return top == 0;
 }
 
-template <class T>
-inline bool TStack<T>::IsFull() const
+template <class T, class Allocator>
+inline bool TStack<T, Allocator>::IsFull() const
 {
     return top == capacity;
 }
 
 // итератор
-template <class T>
-inline TStack<T>::TIterator::TIterator(TStack<T> &stack, size_t start_pos, size_t passed_count)
+template <class T, class Allocator>
+inline TStack<T, Allocator>::TIterator::TIterator(TStack<T, Allocator> &stack, size_t start_pos, size_t passed_count)
     : p(stack), current(start_pos), passed(passed_count) {}
 
-template <class T>
-inline T& TStack<T>::TIterator::operator*()
+template <class T, class Allocator>
+inline T& TStack<T, Allocator>::TIterator::operator*()
 {
     return p.memory[current];
 }
 
-template <class T>
-inline typename TStack<T>::TIterator& TStack<T>::TIterator::operator++()
+template <class T, class Allocator>
+inline typename TStack<T, Allocator>::TIterator& TStack<T, Allocator>::TIterator::operator++()
 {
     current++;
     passed++;
     return *this;
 }
 
-template <class T>
-inline typename TStack<T>::TIterator TStack<T>::TIterator::operator++(int)
+template <class T, class Allocator>
+inline typename TStack<T, Allocator>::TIterator TStack<T, Allocator>::TIterator::operator++(int)
 {
     TIterator temp = *this;
     ++(*this);
     return temp;
 }
 
-template <class T>
-inline bool TStack<T>::TIterator::operator==(const TIterator& other) const
+template <class T, class Allocator>
+inline bool TStack<T, Allocator>::TIterator::operator==(const TIterator& other) const
 {
     return &p == &other.p && passed == other.passed;
 }
 
-template <class T>
-inline bool TStack<T>::TIterator::operator!=(const TIterator& other) const
+template <class T, class Allocator>
+inline bool TStack<T, Allocator>::TIterator::operator!=(const TIterator& other) const
 {
     return !(*this == other);
 }
 
-template <class T>
-inline typename TStack<T>::TIterator TStack<T>::begin()
+template <class T, class Allocator>
+inline typename TStack<T, Allocator>::TIterator TStack<T, Allocator>::begin()
 {
     return TIterator(*this, 0, 0);
 }
 
-template <class T>
-inline typename TStack<T>::TIterator TStack<T>::end()
+template <class T, class Allocator>
+inline typename TStack<T, Allocator>::TIterator TStack<T, Allocator>::end()
 {
     return TIterator(*this, top, top);
 }
 
 
 
-template <class T>
-inline T TStack<T>::Min() const
+template <class T, class Allocator>
+inline T TStack<T, Allocator>::Min() const
 {
   if (IsEmpty())
     throw "Stack is empty";
 
+  // для int, float и double - векторное ядро с тем же результатом
+  if constexpr (HasMinKernel<T>)
+    return MinKernel(memory[0], memory + 1, top - 1);
+
   // инициализация минимума первым элементом
   T minElement = memory[0];
 
@@ -290,4 +439,8 @@ inline T TStack<T>::Min() const
   }
 
   return minElement;
-}
\ No newline at end of file
+}
+
+// Стек в памяти std::pmr::memory_resource (арена, пул потока)
+template <class T>
+using TPmrStack = TStack<T, pmr::polymorphic_allocator<T>>;
\ No newline at end of file
@@ -0,0 +1 @@
+#include "TreeClass.h"
\ No newline at end of file
@@ -0,0 +1,356 @@
+#pragma once
+#include <cstddef>
+#include <vector>
+#include <type_traits>
+#include "ProgramClass.h"
+
+using namespace std;
+
+// Узел дерева выражения. Потомки задаются индексами в массиве узлов,
+// их индексы всегда меньше индекса родителя.
+template <class T>
+struct TNode
+{
+  TOpCode code;
+  unsigned slot;  // номер переменной для OpVar
+  unsigned left;  // потомки для операций
+  unsigned right;
+  T value;        // значение для OpConst
+};
+
+// Дерево выражения. Все узлы лежат подряд в одном массиве (арене):
+// новый узел дописывается в конец, память освобождается целиком.
+// Корень задается явно (Build или SetRoot); узлы, недостижимые из корня,
+// остаются в арене, но не вычисляются. При задании корня достижимые узлы
+// выписываются в порядок вычисления, Evaluate идет по нему без обхода дерева.
+template <class T>
+class TExprTree
+{
+protected:
+  // Шаг вычисления: узел и номера шагов его потомков
+  struct TStep
+  {
+    unsigned node;
+    unsigned left;
+    unsigned right;
+  };
+
+  vector<TNode<T>> nodes;
+  unsigned root;
+  vector<TStep> steps; // достижимые из корня узлы, потомки раньше родителей
+  bool shared;         // у какого-то узла больше одного родителя
+  bool variables;      // среди шагов есть переменные
+
+  static_assert(is_trivially_destructible_v<TNode<T>>, "Tree nodes must be trivially destructible");
+
+  static constexpr unsigned NoRoot = 0xFFFFFFFFu;
+  static constexpr size_t LocalSteps = 64;
+
+  unsigned Allocate(const TNode<T>& node);
+  // Порядок вычисления для текущего корня
+  void Schedule();
+  void Check(const T* values) const;
+  T Execute(const T* values, T* result) const;
+public:
+  TExprTree();
+
+  // Построение по постфиксной программе за один проход
+  void Build(const TProgram<T>& program);
+  // Сброс арены без освобождения памяти
+  void Clear();
+
+  unsigned AddConst(const T& value);
+  unsigned AddVariable(unsigned slot);
+  unsigned AddOperator(TOpCode code, unsigned left, unsigned right);
+
+  size_t Size() const;
+  bool IsEmpty() const;
+  bool HasRoot() const;
+  unsigned GetRoot() const;
+  void SetRoot(unsigned root_);
+  const TNode<T>& operator[](unsigned index) const;
+
+  // Высота дерева от корня
+  size_t Height() const;
+  // Значение корня; values[k] - значение переменной в ячейке k.
+  // Большим деревьям нужен буфер: без scratch он выделяется на каждый вызов
+  T Evaluate(const T* values = nullptr) const;
+  T Evaluate(const T* values, vector<T>& scratch) const;
+  // Постфиксная программа для корня. Дерево с общими поддеревьями отвергается:
+  // в программе они повторялись бы, и ее длина росла бы экспоненциально
+  void ToProgram(TProgram<T>& program) const;
+};
+
+template <class T>
+inline TExprTree<T>::TExprTree() : root(NoRoot), shared(false), variables(false) {}
+
+template <class T>
+inline unsigned TExprTree<T>::Allocate(const TNode<T>& node)
+{
+  nodes.push_back(node);
+  return nodes.size() - 1;
+}
+
+template <class T>
+inline void TExprTree<T>::Schedule()
+{
+  steps.clear();
+  shared = false;
+  variables = false;
+  if (root == NoRoot)
+    return;
+  // Потомки стоят раньше родителей: один проход от корня вниз размечает достижимые
+  // и находит узлы, на которые ссылаются дважды
+  vector<unsigned> position(root + 1, NoRoot);
+  position[root] = 0;
+  size_t count = 0;
+  for (unsigned i = root + 1; i-- > 0;)
+  {
+    if (position[i] == NoRoot)
+      continue;
+    count++;
+    const TNode<T>& node = nodes[i];
+    if (node.code != OpConst && node.code != OpVar)
+    {
+      shared |= position[node.left] != NoRoot || node.left == node.right;
+      position[node.left] = 0;
+      shared |= position[node.right] != NoRoot && node.left != node.right;
+      position[node.right] = 0;
+    }
+  }
+  // Шаги по возрастанию индексов, ссылки на потомков - номера их шагов
+  steps.reserve(count);
+  for (unsigned i = 0; i <= root; ++i)
+  {
+    if (position[i] == NoRoot)
+      continue;
+    const TNode<T>& node = nodes[i];
+    position[i] = steps.size();
+    variables |= node.code == OpVar;
+    if (node.code == OpConst || node.code == OpVar)
+      steps.push_back({i, 0, 0});
+    else
+      steps.push_back({i, position[node.left], position[node.right]});
+  }
+}
+
+template <class T>
+inline void TExprTree<T>::Build(const TProgram<T>& program)
+{
+  if (!program.IsValid())
+    throw "Stack is empty";
+  Clear();
+  nodes.reserve(program.Size());
+
+  // Стек индексов вместо стека значений
+  vector<unsigned> operands;
+  operands.reserve(program.GetDepth());
+  for (size_t i = 0; i < program.Size(); ++i)
+  {
+    const TInstruction<T>& ins = program[i];
+    if (ins.code == OpConst)
+      operands.push_back(AddConst(ins.value));
+    else if (ins.code == OpVar)
+      operands.push_back(AddVariable(ins.slot));
+    else
+    {
+      unsigned right = operands.back();
+      operands.pop_back();
+      unsigned left = operands.back();
+      operands.back() = AddOperator(ins.code, left, right);
+    }
+  }
+  root = operands.back();
+  Schedule();
+}
+
+template <class T>
+inline void TExprTree<T>::Clear()
+{
+  nodes.clear();
+  root = NoRoot;
+  Schedule();
+}
+
+template <class T>
+inline unsigned TExprTree<T>::AddConst(const T& value)
+{
+  return Allocate({OpConst, 0, 0, 0, value});
+}
+
+template <class T>
+inline unsigned TExprTree<T>::AddVariable(unsigned slot)
+{
+  return Allocate({OpVar, slot, 0, 0, T()});
+}
+
+template <class T>
+inline unsigned TExprTree<T>::AddOperator(TOpCode code, unsigned left, unsigned right)
+{
+  if (code == OpConst || code == OpVar)
+    throw "Unknown operator";
+  if (left >= nodes.size() || right >= nodes.size())
+    throw "Index out of range";
+  return Allocate({code, 0, left, right, T()});
+}
+
+template <class T>
+inline size_t TExprTree<T>::Size() const
+{
+  return nodes.size();
+}
+
+template <class T>
+inline bool TExprTree<T>::IsEmpty() const
+{
+  return nodes.empty();
+}
+
+template <class T>
+inline bool TExprTree<T>::HasRoot() const
+{
+  return root != NoRoot;
+}
+
+template <class T>
+inline unsigned TExprTree<T>::GetRoot() const
+{
+  if (!HasRoot())
+    throw "Tree has no root";
+  return root;
+}
+
+template <class T>
+inline void TExprTree<T>::SetRoot(unsigned root_)
+{
+  if (root_ >= nodes.size())
+    throw "Index out of range";
+  root = root_;
+  Schedule();
+}
+
+template <class T>
+inline const TNode<T>& TExprTree<T>::operator[](unsigned index) const
+{
+  if (index >= nodes.size())
+    throw "Index out of range";
+  return nodes[index];
+}
+
+template <class T>
+inline size_t TExprTree<T>::Height() const
+{
+  if (!HasRoot())
+    return 0;
+  // Потомки стоят раньше родителей, поэтому хватает одного прохода по шагам
+  vector<size_t> height(steps.size());
+  for (size_t i = 0; i < steps.size(); ++i)
+  {
+    const TStep& step = steps[i];
+    TOpCode code = nodes[step.node].code;
+    if (code == OpConst || code == OpVar)
+      height[i] = 1;
+    else
+      height[i] = 1 + max(height[step.left], height[step.right]);
+  }
+  return height.back();
+}
+
+template <class T>
+inline T TExprTree<T>::Execute(const T* values, T* result) const
+{
+  for (size_t i = 0; i < steps.size(); ++i)
+  {
+    const TStep& step = steps[i];
+    const TNode<T>& node = nodes[step.node];
+    switch (node.code)
+    {
+      case OpConst:
+        result[i] = node.value;
+        break;
+      case OpVar:
+        result[i] = values[node.slot];
+        break;
+      case OpAdd:
+        result[i] = result[step.left] + result[step.right];
+        break;
+      case OpSub:
+        result[i] = result[step.left] - result[step.right];
+        break;
+      case OpMul:
+        result[i] = result[step.left] * result[step.right];
+        break;
+      case OpDiv:
+        result[i] = result[step.left] / result[step.right];
+        break;
+    }
+  }
+  return result[steps.size() - 1];
+}
+
+template <class T>
+inline void TExprTree<T>::Check(const T* values) const
+{
+  if (IsEmpty())
+    throw "Tree is empty";
+  if (!HasRoot())
+    throw "Tree has no root";
+  if (variables && values == nullptr)
+    throw "Variables are not bound";
+}
+
+template <class T>
+inline T TExprTree<T>::Evaluate(const T* values) const
+{
+  Check(values);
+  if (steps.size() <= LocalSteps)
+  {
+    T result[LocalSteps];
+    return Execute(values, result);
+  }
+  vector<T> result(steps.size());
+  return Execute(values, result.data());
+}
+
+template <class T>
+inline T TExprTree<T>::Evaluate(const T* values, vector<T>& scratch) const
+{
+  Check(values);
+  if (scratch.size() < steps.size())
+    scratch.resize(steps.size());
+  return Execute(values, scratch.data());
+}
+
+template <class T>
+inline void TExprTree<T>::ToProgram(TProgram<T>& program) const
+{
+  if (IsEmpty())
+    throw "Tree is empty";
+  if (!HasRoot())
+    throw "Tree has no root";
+  if (shared)
+    throw "Tree has shared subtrees";
+  program.Clear();
+
+  // Обход в обратном порядке без рекурсии: второй флаг - потомки уже выписаны
+  vector<pair<unsigned, bool>> stack;
+  stack.push_back({root, false});
+  while (!stack.empty())
+  {
+    auto [index, expanded] = stack.back();
+    stack.pop_back();
+    const TNode<T>& node = nodes[index];
+    if (node.code == OpConst)
+      program.PushConst(node.value);
+    else if (node.code == OpVar)
+      program.PushVariable(node.slot);
+    else if (expanded)
+      program.PushOperator(node.code);
+    else
+    {
+      stack.push_back({index, true});
+      stack.push_back({node.right, false});
+      stack.push_back({node.left, false});
+    }
+  }
+}
\ No newline at end of file
@@ -0,0 +1 @@
+#include "WorkStealingDequeClass.h"
\ No newline at end of file
@@ -0,0 +1,193 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <atomic>
+#include <bit>
+#include <type_traits>
+#include "SpscQueueClass.h"
+
+using namespace std;
+
+// Дека для перехвата работы (Чейз - Лев).
+// Владелец кладет и снимает элементы с нижнего конца без CAS,
+// остальные потоки перехватывают их с верхнего конца через CAS на top.
+// Память - кольцо как у TQueue: ячейка равна счетчику по маске,
+// при заполнении владелец переносит элементы в кольцо вдвое больше.
+// Старые кольца освобождаются в деструкторе: их еще могут читать перехватчики.
+// T копируется в atomic<T>, поэтому должен быть тривиально копируемым и небольшим.
+template <class T>
+class TWorkStealingDeque
+{
+  static_assert(is_trivially_copyable_v<T>, "Deque elements must be trivially copyable");
+protected:
+  struct TRing
+  {
+    size_t capacity;
+    size_t mask;
+    atomic<T>* items;
+    TRing* previous; // прежнее, меньшее кольцо
+
+    TRing(size_t capacity_, TRing* previous_);
+    ~TRing();
+    T Get(int64_t index) const;
+    void Put(int64_t index, const T& element);
+  };
+
+  alignas(CacheLine) atomic<int64_t> top;    // следующий элемент для перехвата
+  alignas(CacheLine) atomic<int64_t> bottom; // следующая свободная ячейка владельца
+  atomic<TRing*> ring;
+  char padding[CacheLine - sizeof(atomic<int64_t>) - sizeof(atomic<TRing*>)];
+
+  TRing* Grow(TRing* old, int64_t from, int64_t to);
+public:
+  // Емкость округляется вверх до степени двойки
+  TWorkStealingDeque(size_t capacity_ = 64);
+  TWorkStealingDeque(const TWorkStealingDeque& other) = delete;
+  ~TWorkStealingDeque();
+
+  size_t GetCapacity() const;
+
+  // Вызываются только из потока владельца
+  void push(const T& element);
+  bool try_pop(T& element);
+
+  // Вызывается из любого потока; false, если пусто или элемент забрали раньше
+  bool try_steal(T& element);
+
+  // При одновременных операциях значения приблизительны
+  size_t Size() const;
+  bool IsEmpty() const;
+};
+
+template <class T>
+inline TWorkStealingDeque<T>::TRing::TRing(size_t capacity_, TRing* previous_)
+    : capacity(capacity_), mask(capacity_ - 1), items(new atomic<T>[capacity_]), previous(previous_) {}
+
+template <class T>
+inline TWorkStealingDeque<T>::TRing::~TRing()
+{
+  delete[] items;
+}
+
+template <class T>
+inline T TWorkStealingDeque<T>::TRing::Get(int64_t index) const
+{
+  return items[(size_t)index & mask].load(memory_order_relaxed);
+}
+
+template <class T>
+inline void TWorkStealingDeque<T>::TRing::Put(int64_t index, const T& element)
+{
+  items[(size_t)index & mask].store(element, memory_order_relaxed);
+}
+
+template <class T>
+inline TWorkStealingDeque<T>::TWorkStealingDeque(size_t capacity_) : top(0), bottom(0)
+{
+  if (capacity_ == 0)
+    throw "Deque capacity must be positive";
+  // Большая степень двойки не помещается в size_t
+  if (capacity_ > (SIZE_MAX >> 1) + 1)
+    throw "Deque capacity is too large";
+  ring.store(new TRing(bit_ceil(capacity_), nullptr), memory_order_relaxed);
+}
+
+template <class T>
+inline TWorkStealingDeque<T>::~TWorkStealingDeque()
+{
+  TRing* current = ring.load(memory_order_relaxed);
+  while (current)
+  {
+    TRing* previous = current->previous;
+    delete current;
+    current = previous;
+  }
+}
+
+template <class T>
+inline size_t TWorkStealingDeque<T>::GetCapacity() const
+{
+  return ring.load(memory_order_relaxed)->capacity;
+}
+
+template <class T>
+inline typename TWorkStealingDeque<T>::TRing* TWorkStealingDeque<T>::Grow(TRing* old, int64_t from, int64_t to)
+{
+  TRing* grown = new TRing(old->capacity * 2, old);
+  for (int64_t i = from; i < to; ++i)
+    grown->Put(i, old->Get(i));
+  ring.store(grown, memory_order_release);
+  return grown;
+}
+
+template <class T>
+inline void TWorkStealingDeque<T>::push(const T& element)
+{
+  int64_t b = bottom.load(memory_order_relaxed);
+  int64_t t = top.load(memory_order_acquire);
+  TRing* current = ring.load(memory_order_relaxed);
+  if (b - t >= (int64_t)current->capacity)
+    current = Grow(current, t, b);
+  current->Put(b, element);
+  // Элемент виден перехватчикам раньше нового bottom
+  atomic_thread_fence(memory_order_release);
+  bottom.store(b + 1, memory_order_relaxed);
+}
+
+template <class T>
+inline bool TWorkStealingDeque<T>::try_pop(T& element)
+{
+  int64_t b = bottom.load(memory_order_relaxed) - 1;
+  TRing* current = ring.load(memory_order_relaxed);
+  bottom.store(b, memory_order_relaxed);
+  // Уменьшение bottom должно стать видимым до чтения top
+  atomic_thread_fence(memory_order_seq_cst);
+  int64_t t = top.load(memory_order_relaxed);
+  if (t > b)
+  {
+    // Пусто
+    bottom.store(b + 1, memory_order_relaxed);
+    return false;
+  }
+  T candidate = current->Get(b);
+  if (t == b)
+  {
+    // Последний элемент: спорим с перехватчиками за top, проигравший element не трогает
+    bool won = top.compare_exchange_strong(t, t + 1, memory_order_seq_cst, memory_order_relaxed);
+    bottom.store(b + 1, memory_order_relaxed);
+    if (!won)
+      return false;
+  }
+  element = candidate;
+  return true;
+}
+
+template <class T>
+inline bool TWorkStealingDeque<T>::try_steal(T& element)
+{
+  int64_t t = top.load(memory_order_acquire);
+  atomic_thread_fence(memory_order_seq_cst);
+  int64_t b = bottom.load(memory_order_acquire);
+  if (t >= b)
+    return false;
+  TRing* current = ring.load(memory_order_acquire);
+  T candidate = current->Get(t);
+  if (!top.compare_exchange_strong(t, t + 1, memory_order_seq_cst, memory_order_relaxed))
+    return false;
+  element = candidate;
+  return true;
+}
+
+template <class T>
+inline size_t TWorkStealingDeque<T>::Size() const
+{
+  int64_t b = bottom.load(memory_order_acquire);
+  int64_t t = top.load(memory_order_acquire);
+  return b > t ? (size_t)(b - t) : 0;
+}
+
+template <class T>
+inline bool TWorkStealingDeque<T>::IsEmpty() const
+{
+  return Size() == 0;
+}
\ No newline at end of file
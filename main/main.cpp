@@ -1,7 +1,218 @@
 #include <iostream>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <thread>
+#include <chrono>
+#include <memory>
+#include <cstring>
+#include <cstdlib>
+#include "BatchClass.h"
+#include "SchedulerClass.h"
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define HAVE_MMAP 1
+#endif
+
 using namespace std;
 
-int main()
+// Пакетный вычислитель: одно выражение в строке, результаты в порядке входа.
+// QueueStackLab <input|-> [output] [--mmap] [--threads N]
+// Время и пропускная способность каждого этапа печатаются в stderr.
+
+struct TOptions
+{
+  string input;
+  string output;
+  bool useMmap = false;
+  size_t threads = 0;
+};
+
+// Входной текст: отображенный в память файл или прочитанный буфер
+class TInput
+{
+  string buffer;
+  const char* data = nullptr;
+  size_t size = 0;
+#ifdef HAVE_MMAP
+  void* mapped = nullptr;
+#endif
+public:
+  void Read(const string& path, bool useMmap)
+  {
+#ifdef HAVE_MMAP
+    if (useMmap && path != "-")
+    {
+      int fd = open(path.c_str(), O_RDONLY);
+      if (fd < 0)
+        throw "Cannot open input";
+      struct stat st;
+      if (fstat(fd, &st) == 0 && st.st_size > 0)
+      {
+        mapped = mmap(nullptr, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (mapped == MAP_FAILED)
+          mapped = nullptr;
+        else
+        {
+          data = (const char*)mapped;
+          size = st.st_size;
+        }
+      }
+      close(fd);
+      if (mapped)
+        return;
+    }
+#endif
+    ostringstream text;
+    if (path == "-")
+      text << cin.rdbuf();
+    else
+    {
+      ifstream file(path, ios::binary);
+      if (!file)
+        throw "Cannot open input";
+      text << file.rdbuf();
+    }
+    buffer = text.str();
+    data = buffer.data();
+    size = buffer.size();
+  }
+
+  // Строки без завершающих \r\n
+  vector<string_view> Lines() const
+  {
+    vector<string_view> lines;
+    size_t begin = 0;
+    while (begin < size)
+    {
+      const char* end = (const char*)memchr(data + begin, '\n', size - begin);
+      size_t length = end ? end - (data + begin) : size - begin;
+      string_view line(data + begin, length);
+      if (!line.empty() && line.back() == '\r')
+        line.remove_suffix(1);
+      lines.push_back(line);
+      begin += length + 1;
+    }
+    return lines;
+  }
+
+  ~TInput()
+  {
+#ifdef HAVE_MMAP
+    if (mapped)
+      munmap(mapped, size);
+#endif
+  }
+};
+
+// Время этапа в секундах
+template <class F>
+static double Timed(F f)
+{
+  auto begin = chrono::steady_clock::now();
+  f();
+  return chrono::duration<double>(chrono::steady_clock::now() - begin).count();
+}
+
+static void Report(const char* phase, size_t count, double seconds)
+{
+  cerr << phase << ": " << seconds * 1000 << " ms, ";
+  if (seconds > 0)
+    cerr << count / seconds << " expr/s\n";
+  else
+    cerr << "- expr/s\n";
+}
+
+static bool ParseOptions(int argc, char** argv, TOptions& options)
+{
+  vector<string> positional;
+  for (int i = 1; i < argc; ++i)
+  {
+    string arg = argv[i];
+    if (arg == "--mmap")
+      options.useMmap = true;
+    else if (arg == "--threads" && i + 1 < argc)
+      options.threads = strtoull(argv[++i], nullptr, 10);
+    else if (arg.size() > 2 && arg.compare(0, 2, "--") == 0)
+      return false;
+    else
+      positional.push_back(arg);
+  }
+  if (positional.empty() || positional.size() > 2)
+    return false;
+  options.input = positional[0];
+  if (positional.size() == 2)
+    options.output = positional[1];
+  if (options.threads == 0)
+    options.threads = max(1u, thread::hardware_concurrency());
+  return true;
+}
+
+int main(int argc, char** argv)
 {
+  TOptions options;
+  if (!ParseOptions(argc, argv, options))
+  {
+    cout << "usage: " << argv[0] << " <input|-> [output] [--mmap] [--threads N]\n";
+    return argc > 1 ? 1 : 0;
+  }
+
+  try
+  {
+    // Потоки создаются один раз на все этапы
+    TScheduler scheduler(options.threads);
+    TInput input;
+    vector<string_view> lines;
+    unique_ptr<TBatch<double>> batch;
+    double reading = Timed([&] {
+      input.Read(options.input, options.useMmap);
+      lines = input.Lines();
+      batch.reset(new TBatch<double>(scheduler, lines));
+    });
+    size_t count = lines.size();
+
+    double checking = Timed([&] { batch->Check(); });
+    double conversion = Timed([&] { batch->Convert(); });
+    double evaluation = Timed([&] { batch->Evaluate(); });
+
+    ofstream file;
+    if (!options.output.empty())
+    {
+      file.open(options.output);
+      if (!file)
+        throw "Cannot open output";
+    }
+    ostream& out = options.output.empty() ? cout : file;
+
+    double writing = Timed([&] {
+      string text;
+      batch->Write(text);
+      out << text;
+      out.flush();
+    });
+
+    cerr << "expressions: " << count << ", threads: " << options.threads << "\n";
+    Report("reading", count, reading);
+    Report("checking", count, checking);
+    Report("conversion", count, conversion);
+    Report("evaluation", count, evaluation);
+    Report("writing", count, writing);
+  }
+  catch (const char* error)
+  {
+    cerr << "error: " << error << "\n";
+    return 1;
+  }
+  catch (const exception& error)
+  {
+    cerr << "error: " << error.what() << "\n";
+    return 1;
+  }
   return 0;
 }
\ No newline at end of file
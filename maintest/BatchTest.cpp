@@ -0,0 +1,55 @@
+#include <gtest.h>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "BatchClass.h"
+
+// Ошибочные строки не мешают вычислению остальных
+TEST(TBatchTest, BadLinesReportedPerLine)
+{
+  std::vector<std::string_view> lines = {"1+2", "$4294967295+1", "3*4", "", "(1+2", "x+1", "10/4"};
+  TScheduler scheduler(4);
+  TBatch<double> batch(scheduler, lines);
+  batch.Run();
+
+  ASSERT_EQ(batch.Size(), 7);
+  EXPECT_EQ(batch.GetResult(0), 3);
+  EXPECT_EQ(batch.GetError(1), "Slot index is too large");
+  EXPECT_EQ(batch.GetResult(2), 12);
+  EXPECT_EQ(batch.GetError(3), "empty expression");
+  EXPECT_EQ(batch.GetError(4), "unbalanced brackets");
+  EXPECT_EQ(batch.GetError(5), "Variables are not bound");
+  EXPECT_EQ(batch.GetResult(6), 2.5);
+  EXPECT_THROW(batch.GetResult(1), const char*);
+
+  std::string text;
+  batch.Write(text);
+  EXPECT_EQ(text, "3\nerror: Slot index is too large\n12\nerror: empty expression\n"
+                  "error: unbalanced brackets\nerror: Variables are not bound\n2.5\n");
+}
+
+// Один пул на несколько пакетов, строк больше, чем кусков на поток
+TEST(TBatchTest, SharedScheduler)
+{
+  std::vector<std::string> texts;
+  for (int i = 0; i < 1000; ++i)
+    texts.push_back(i % 97 == 0 ? "$99999999999" : std::to_string(i) + "*2");
+  std::vector<std::string_view> lines(texts.begin(), texts.end());
+
+  TScheduler scheduler(3);
+  for (int round = 0; round < 3; ++round)
+  {
+    TBatch<long long> batch(scheduler, lines);
+    batch.Run();
+    for (int i = 0; i < 1000; ++i)
+    {
+      if (i % 97 == 0)
+      {
+        EXPECT_TRUE(batch.IsError(i));
+      } else
+      {
+        EXPECT_EQ(batch.GetResult(i), 2 * i);
+      }
+    }
+  }
+}
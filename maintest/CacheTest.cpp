@@ -0,0 +1,91 @@
+#include <gtest.h>
+#include <string>
+#include <thread>
+#include <vector>
+#include "CacheClass.h"
+
+// Тест попаданий и промахов
+TEST(TFormulaCacheTest, HitsAndMisses)
+{
+  TFormulaCache<double> cache(16, 4);
+  auto first = cache.Get("(2*3.5+1)*x");
+  auto second = cache.Get("(2*3.5+1)*x");
+
+  EXPECT_EQ(first, second); // тот же скомпилированный объект
+  EXPECT_EQ(cache.GetMisses(), 1);
+  EXPECT_EQ(cache.GetHits(), 1);
+  EXPECT_EQ(cache.Size(), 1);
+
+  // Программа уже упрощена и связана с именами
+  ASSERT_EQ(first->variables.size(), 1);
+  EXPECT_EQ(first->variables[0], "x");
+  EXPECT_EQ(first->program.Size(), 3);
+  double x = 2.0;
+  EXPECT_DOUBLE_EQ(first->program.Run(&x), 16.0);
+}
+
+// Тест вытеснения давно не использованных формул
+TEST(TFormulaCacheTest, LeastRecentlyUsedEviction)
+{
+  TFormulaCache<int> cache(2, 1);
+  cache.Get("1+1");
+  cache.Get("2+2");
+  cache.Get("1+1"); // 2+2 становится самой старой
+  cache.Get("3+3");
+
+  EXPECT_EQ(cache.Size(), 2);
+  EXPECT_EQ(cache.GetEvictions(), 1);
+
+  size_t misses = cache.GetMisses();
+  cache.Get("1+1");
+  EXPECT_EQ(cache.GetMisses(), misses);
+  cache.Get("2+2");
+  EXPECT_EQ(cache.GetMisses(), misses + 1);
+}
+
+// Тест ограничения размера
+TEST(TFormulaCacheTest, BoundedSize)
+{
+  TFormulaCache<int> cache(64, 8);
+  for (int i = 0; i < 1000; ++i)
+    cache.Get(std::to_string(i) + "+x");
+
+  EXPECT_LE(cache.Size(), cache.GetCapacity());
+  EXPECT_EQ(cache.GetMisses(), 1000);
+  EXPECT_EQ(cache.GetEvictions(), 1000 - cache.Size());
+
+  cache.Clear();
+  EXPECT_EQ(cache.Size(), 0);
+}
+
+// Тест одновременных обращений из нескольких потоков
+TEST(TFormulaCacheTest, ConcurrentLookups)
+{
+  TFormulaCache<long long> cache(1024, 16);
+  const int threads = 8, lookups = 5000, formulas = 100;
+
+  std::vector<std::thread> pool;
+  std::vector<int> wrong(threads, 0);
+  for (int t = 0; t < threads; ++t)
+  {
+    pool.emplace_back([&, t] {
+      for (int i = 0; i < lookups; ++i)
+      {
+        int k = (i * 7 + t) % formulas;
+        auto compiled = cache.Get(std::to_string(k) + "*x+1");
+        long long x = 3;
+        if (compiled->program.Run(&x) != 3LL * k + 1)
+          wrong[t]++;
+      }
+    });
+  }
+  for (auto& thread : pool)
+    thread.join();
+
+  for (int t = 0; t < threads; ++t)
+    EXPECT_EQ(wrong[t], 0);
+  EXPECT_EQ(cache.GetHits() + cache.GetMisses(), (size_t)threads * lookups);
+  EXPECT_GE(cache.GetMisses(), (size_t)formulas);
+  EXPECT_EQ(cache.Size(), (size_t)formulas);
+  EXPECT_EQ(cache.GetEvictions(), 0);
+}
@@ -0,0 +1,112 @@
+#include <gtest.h>
+#include <memory>
+#include <string>
+#include "ChunkStackClass.h"
+
+namespace
+{
+  // Счетчики общие для всех типов: стек выделяет блоки через rebind
+  int allocations = 0;
+  int live = 0;
+
+  template <class T>
+  struct TCountingAllocator
+  {
+    using value_type = T;
+
+    TCountingAllocator() = default;
+    template <class U>
+    TCountingAllocator(const TCountingAllocator<U>&) {}
+
+    T* allocate(std::size_t n)
+    {
+      allocations++;
+      live++;
+      return std::allocator<T>().allocate(n);
+    }
+    void deallocate(T* p, std::size_t n)
+    {
+      live--;
+      std::allocator<T>().deallocate(p, n);
+    }
+    template <class U>
+    bool operator==(const TCountingAllocator<U>&) const { return true; }
+  };
+}
+
+TEST(TChunkStackTest, PushPopAcrossChunks)
+{
+  TChunkStack<int, 4> stack;
+  EXPECT_TRUE(stack.IsEmpty());
+  EXPECT_THROW(stack.pop(), const char*);
+  for (int i = 0; i < 50; ++i)
+    stack.push(i);
+  EXPECT_EQ(stack.Size(), 50);
+  EXPECT_EQ(stack.GetChunkCount(), 13);
+  for (int i = 49; i >= 0; --i)
+  {
+    EXPECT_EQ(stack.Peek(), i);
+    EXPECT_EQ(stack.pop(), i);
+  }
+  EXPECT_TRUE(stack.IsEmpty());
+  EXPECT_THROW(stack.Peek(), const char*);
+}
+
+TEST(TChunkStackTest, SpareChunkAtBoundary)
+{
+  using TAlloc = TCountingAllocator<int>;
+  TChunkStack<int, 4, TAlloc> stack;
+  for (int i = 0; i < 4; ++i)
+    stack.push(i);
+  // Колебание на границе блоков выделяет память один раз
+  int before = allocations;
+  for (int i = 0; i < 100; ++i)
+  {
+    stack.push(10);
+    stack.push(11);
+    stack.pop();
+    stack.pop();
+    stack.pop();
+    stack.push(3);
+  }
+  EXPECT_EQ(allocations - before, 1);
+  EXPECT_EQ(stack.Size(), 4);
+  EXPECT_EQ(stack.Peek(), 3);
+
+  // При уменьшении лишние блоки возвращаются: остается не больше одного запасного
+  for (int i = 0; i < 40; ++i)
+    stack.push(i);
+  while (stack.Size() > 2)
+    stack.pop();
+  EXPECT_LE(stack.GetChunkCount(), 2);
+  stack.ShrinkToFit();
+  EXPECT_EQ(stack.GetChunkCount(), 1);
+  stack.Clear();
+  EXPECT_EQ(live, 0);
+}
+
+TEST(TChunkStackTest, ElementsAreNeverMoved)
+{
+  TChunkStack<std::string, 3> stack;
+  std::string& bottom = stack.emplace("bottom");
+  const std::string* address = &bottom;
+  for (int i = 0; i < 100; ++i)
+    stack.push(std::to_string(i));
+  EXPECT_EQ(*address, "bottom");
+
+  TChunkStack<std::string, 3> moved(std::move(stack));
+  EXPECT_TRUE(stack.IsEmpty());
+  EXPECT_EQ(moved.Size(), 101);
+  std::string top;
+  moved.pop_into(top);
+  EXPECT_EQ(top, "99");
+}
+
+TEST(TChunkStackTest, MoveOnlyElements)
+{
+  TChunkStack<std::unique_ptr<int>, 2> stack;
+  for (int i = 0; i < 5; ++i)
+    stack.push(std::make_unique<int>(i));
+  EXPECT_EQ(*stack.pop(), 4);
+  EXPECT_EQ(stack.Size(), 4);
+}
@@ -40,6 +40,26 @@ TEST(TFormulaTest, FormulaChecker_CorrectExpressions) {
 }
 
 // Тест проверки скобок - некорректные выражения
+// Вложенность глубже встроенной емкости стека скобок
+TEST(TFormulaTest, FormulaChecker_DeepNesting) {
+  const int depth = 5000;
+  std::string expr = std::string(depth, '(') + "1" + std::string(depth, ')');
+  TFormula<double> formula(expr);
+  std::vector<int> brackets(2 * depth);
+  EXPECT_EQ(formula.FormulaChecker(brackets.data(), brackets.size()), 0);
+  // Первой закрывается самая внутренняя пара
+  EXPECT_EQ(brackets[0], depth);
+  EXPECT_EQ(brackets[1], depth + 2);
+  EXPECT_EQ(brackets[2 * depth - 2], 1);
+  EXPECT_EQ(brackets[2 * depth - 1], 2 * depth + 1);
+
+  // Массив меньше числа пар: исключение вместо записи за его границу
+  EXPECT_THROW(formula.FormulaChecker(brackets.data(), 2 * depth - 1), const char*);
+  TFormula<double> unclosed(std::string(depth, '('));
+  EXPECT_THROW(unclosed.FormulaChecker(brackets.data(), 10), const char*);
+  EXPECT_EQ(unclosed.FormulaChecker(brackets.data(), brackets.size()), depth);
+}
+
 TEST(TFormulaTest, FormulaChecker_IncorrectExpressions) {
   {
     char expr[] = "(1+2";
@@ -128,13 +148,6 @@ TEST(TFormulaTest, FormulaConverter_FloatingPoint) {
 
 // Тест с игнорированием некорректных символов
 TEST(TFormulaTest, FormulaConverter_IgnoreInvalidChars) {
-  {
-    char expr[] = "a1b+c2d";
-    TFormula<double> formula(expr);
-    EXPECT_EQ(formula.FormulaConverter(), 0);
-    EXPECT_DOUBLE_EQ(formula.FormulaCalculator(), 3.0); // 1 + 2 = 3
-  }
-
   {
     char expr[] = "1@+2#";
     TFormula<double> formula(expr);
@@ -188,9 +201,8 @@ TEST(TFormulaTest, DifferentDataTypes) {
 
 // Тест обработки длинных выражений
 TEST(TFormulaTest, LongExpression) {
-  char expr[MaxLength];
   // Создаем длинное, но корректное выражение
-  strcpy(expr, "1+2-3*4/5+6-7*8/9+0");
+  char expr[] = "1+2-3*4/5+6-7*8/9+0";
 
   TFormula<double> formula(expr);
 
@@ -207,4 +219,415 @@ TEST(TFormulaTest, LongExpression) {
   // Не проверяем точное значение, так как оно зависит от реализации
   // Главное, что не произошло исключений
   SUCCEED();
-}
\ No newline at end of file
+}
+
+// Тест приоритетов и скобок
+TEST(TFormulaTest, FormulaCalculator_PriorityAndBrackets) {
+  {
+    char expr[] = "1+2*3";
+    TFormula<double> formula(expr);
+    formula.FormulaConverter();
+    EXPECT_DOUBLE_EQ(formula.FormulaCalculator(), 7.0);
+  }
+
+  {
+    char expr[] = "1-2+3";
+    TFormula<int> formula(expr);
+    formula.FormulaConverter();
+    EXPECT_EQ(formula.FormulaCalculator(), 2);
+  }
+
+  {
+    char expr[] = "((1+2)*(3-4))/2";
+    TFormula<double> formula(expr);
+    formula.FormulaConverter();
+    EXPECT_DOUBLE_EQ(formula.FormulaCalculator(), -1.5);
+  }
+}
+
+// Тест скомпилированной программы
+TEST(TFormulaTest, FormulaConverter_Program) {
+  char expr[] = "(1.5+2)*4";
+  TFormula<double> formula(expr);
+  formula.FormulaConverter();
+
+  const TProgram<double>& program = formula.GetProgram();
+  ASSERT_EQ(program.Size(), 5);
+  EXPECT_EQ(program[0].code, OpConst);
+  EXPECT_DOUBLE_EQ(program[0].value, 1.5);
+  EXPECT_EQ(program[1].code, OpConst);
+  EXPECT_EQ(program[2].code, OpAdd);
+  EXPECT_EQ(program[3].code, OpConst);
+  EXPECT_EQ(program[4].code, OpMul);
+  EXPECT_EQ(program.GetDepth(), 2);
+  EXPECT_TRUE(program.IsValid());
+}
+
+// Программа и текст постфиксной формы дают одинаковый результат
+TEST(TFormulaTest, FormulaCalculator_MatchesPostfixText) {
+  const char* exprs[] = {"1+2", "10/3", "2*(3+4)-5/2", "((1.25+2)*3-4)/(8-6)", "1.5*2.5*3.5"};
+  for (const char* e : exprs)
+  {
+    TFormula<double> formula(e);
+    formula.FormulaConverter();
+    EXPECT_DOUBLE_EQ(formula.FormulaCalculator(), formula.PostfixCalculator()) << e;
+  }
+}
+
+// Некорректная программа
+TEST(TFormulaTest, FormulaCalculator_InvalidProgram) {
+  char expr[] = "1+";
+  TFormula<double> formula(expr);
+  formula.FormulaConverter();
+  EXPECT_FALSE(formula.GetProgram().IsValid());
+  EXPECT_THROW(formula.FormulaCalculator(), const char*);
+}
+
+
+// Тест переменных $k
+TEST(TFormulaTest, FormulaCalculator_Variables) {
+  char expr[] = "($0+$1)*$2-4";
+  TFormula<double> formula(expr);
+  formula.FormulaConverter();
+  EXPECT_EQ(formula.GetProgram().GetVariables(), 3);
+
+  double values[] = {1.5, 2.5, 3.0};
+  EXPECT_DOUBLE_EQ(formula.FormulaCalculator(values), 8.0);
+  EXPECT_THROW(formula.FormulaCalculator(), const char*);
+}
+
+// Имена и $k делят ячейки, поэтому смешивать их нельзя
+TEST(TFormulaTest, FormulaConverter_MixedVariables) {
+  EXPECT_THROW(TFormula<double>("x+$0").FormulaConverter(), const char*);
+  EXPECT_THROW(TFormula<double>("$0+x").FormulaConverter(), const char*);
+  // Заранее связанные имена тоже занимают ячейки
+  std::vector<std::string> names = {"x"};
+  EXPECT_THROW(TFormula<double>("$0*2", names).FormulaConverter(), const char*);
+
+  TFormula<double> numbered("$1-$0");
+  numbered.FormulaConverter();
+  EXPECT_TRUE(numbered.GetVariables().empty());
+  double values[] = {1.0, 3.0};
+  EXPECT_DOUBLE_EQ(numbered.FormulaCalculator(values), 2.0);
+}
+
+// Пакетное вычисление совпадает со скалярным построчно
+TEST(TFormulaTest, EvaluateBatch_MatchesScalar) {
+  const size_t rows = 1000; // несколько блоков и неполный последний
+  {
+    char expr[] = "($0+2.5)*$1-$0/($1+1)";
+    TFormula<double> formula(expr);
+    formula.FormulaConverter();
+
+    std::vector<double> x(rows), y(rows), out(rows);
+    for (size_t i = 0; i < rows; ++i)
+    {
+      x[i] = i * 0.5 - 100;
+      y[i] = 3.0 + i % 17;
+    }
+    const double* columns[] = {x.data(), y.data()};
+    formula.EvaluateBatch(columns, out);
+
+    for (size_t i = 0; i < rows; ++i)
+    {
+      double values[] = {x[i], y[i]};
+      EXPECT_EQ(out[i], formula.FormulaCalculator(values)) << i;
+    }
+  }
+
+  {
+    char expr[] = "$0*$0-7*$0+3";
+    TFormula<int> formula(expr);
+    formula.FormulaConverter();
+
+    std::vector<int> x(rows), out(rows);
+    for (size_t i = 0; i < rows; ++i)
+      x[i] = (int)i - 500;
+    const int* columns[] = {x.data()};
+    formula.EvaluateBatch(columns, out);
+
+    for (size_t i = 0; i < rows; ++i)
+      EXPECT_EQ(out[i], formula.FormulaCalculator(&x[i])) << i;
+  }
+}
+
+// Пакетное вычисление без нужных столбцов
+TEST(TFormulaTest, EvaluateBatch_MissingColumns) {
+  char expr[] = "$0+$1";
+  TFormula<double> formula(expr);
+  formula.FormulaConverter();
+
+  std::vector<double> x(10), out(10);
+  const double* columns[] = {x.data()};
+  EXPECT_THROW(formula.EvaluateBatch(columns, out), const char*);
+}
+
+// Слишком большой номер ячейки $k отвергается при разборе
+TEST(TFormulaTest, FormulaConverter_OversizedSlot) {
+  {
+    TFormula<double> formula("$4294967295+1");
+    EXPECT_THROW(formula.FormulaConverter(), const char*);
+  }
+  {
+    TFormula<double> formula("$99999999999999999999*2");
+    EXPECT_THROW(formula.FormulaConverter(), const char*);
+  }
+  {
+    TFormula<double> formula("$65536");
+    EXPECT_THROW(formula.FormulaConverter(), const char*);
+  }
+  TProgram<double> program;
+  EXPECT_THROW(program.PushVariable(4294967295u), const char*);
+  program.PushVariable(TProgram<double>::MaxSlot);
+  EXPECT_EQ(program.GetVariables(), TProgram<double>::MaxSlot + 1);
+}
+
+
+// Тест именованных переменных
+TEST(TFormulaTest, FormulaConverter_Identifiers) {
+  {
+    // Буквы теперь образуют имена переменных, а не отбрасываются
+    char expr[] = "a1b+c2d";
+    TFormula<double> formula(expr);
+    EXPECT_EQ(formula.FormulaConverter(), 0);
+    ASSERT_EQ(formula.GetVariables().size(), 2);
+    EXPECT_EQ(formula.GetVariables()[0], "a1b");
+    EXPECT_EQ(formula.GetVariables()[1], "c2d");
+    double values[] = {1.0, 2.0};
+    EXPECT_DOUBLE_EQ(formula.FormulaCalculator(values), 3.0);
+  }
+
+  {
+    char expr[] = "price*qty+fee-price/qty";
+    TFormula<double> formula(expr);
+    formula.FormulaConverter();
+    EXPECT_EQ(formula.GetVariables().size(), 3);
+    EXPECT_EQ(formula.GetSlot("price"), 0);
+    EXPECT_EQ(formula.GetSlot("qty"), 1);
+    EXPECT_EQ(formula.GetSlot("fee"), 2);
+    EXPECT_EQ(formula.GetSlot("tax"), -1);
+
+    // Одна скомпилированная формула для разных наборов значений
+    double first[] = {10.0, 4.0, 0.5};
+    EXPECT_DOUBLE_EQ(formula.FormulaCalculator(first), 38.0);
+    double second[] = {3.0, 2.0, 1.0};
+    EXPECT_DOUBLE_EQ(formula.FormulaCalculator(second), 5.5);
+  }
+}
+
+// Тест заранее заданной таблицы связывания
+TEST(TFormulaTest, FormulaConverter_PresetBindings) {
+  char expr[] = "x_2-y+z";
+  TFormula<int> formula(expr, {"z", "y"});
+  formula.FormulaConverter();
+
+  EXPECT_EQ(formula.GetSlot("z"), 0);
+  EXPECT_EQ(formula.GetSlot("y"), 1);
+  EXPECT_EQ(formula.GetSlot("x_2"), 2);
+  int values[] = {1, 10, 100};
+  EXPECT_EQ(formula.FormulaCalculator(values), 91);
+}
+
+// Выражения длиннее прежнего ограничения в 255 символов
+TEST(TFormulaTest, VeryLongExpression) {
+  {
+    // 100000 слагаемых, около 200 КБ текста
+    std::string expr = "1";
+    for (int i = 1; i < 100000; ++i)
+      expr += "+1";
+    TFormula<int> formula(expr);
+    int brackets[2];
+    EXPECT_EQ(formula.FormulaChecker(brackets, 2), 0);
+    EXPECT_EQ(formula.FormulaConverter(), 0);
+    EXPECT_EQ(formula.FormulaCalculator(), 100000);
+  }
+
+  {
+    // Глубокая вложенность: стек значений больше локального буфера
+    std::string expr;
+    for (int i = 0; i < 1000; ++i)
+      expr += "(2+";
+    expr += "0";
+    for (int i = 0; i < 1000; ++i)
+      expr += ")";
+    TFormula<long long> formula(expr);
+    EXPECT_EQ(formula.FormulaConverter(), 0);
+    EXPECT_GT(formula.GetProgram().GetDepth(), 1000);
+    EXPECT_EQ(formula.FormulaCalculator(), 2000);
+  }
+}
+
+// Тест свертки констант
+TEST(TFormulaTest, FormulaOptimizer_FoldsConstants) {
+  TFormula<double> formula("(2*3.5+1)*x");
+  formula.FormulaConverter();
+  EXPECT_EQ(formula.GetProgram().Size(), 7);
+
+  EXPECT_EQ(formula.FormulaOptimizer(), 4);
+  const TProgram<double>& program = formula.GetProgram();
+  ASSERT_EQ(program.Size(), 3);
+  EXPECT_EQ(program[0].code, OpConst);
+  EXPECT_DOUBLE_EQ(program[0].value, 8.0);
+  EXPECT_EQ(program[1].code, OpVar);
+  EXPECT_EQ(program[2].code, OpMul);
+
+  double x = 1.25;
+  EXPECT_DOUBLE_EQ(formula.FormulaCalculator(&x), 10.0);
+}
+
+// Тест алгебраических упрощений
+TEST(TFormulaTest, FormulaOptimizer_Identities) {
+  {
+    TFormula<int> formula("(x*1+0)-0+1*(0+y)/1");
+    formula.FormulaConverter();
+    EXPECT_EQ(formula.FormulaOptimizer(), 12);
+    EXPECT_EQ(formula.GetProgram().Size(), 3);
+    int values[] = {5, 7};
+    EXPECT_EQ(formula.FormulaCalculator(values), 12);
+  }
+
+  {
+    // x*0 для целых сворачивается вместе с остальным выражением
+    TFormula<int> formula("(x+y*2)*0+3");
+    formula.FormulaConverter();
+    EXPECT_EQ(formula.FormulaOptimizer(), 8);
+    EXPECT_EQ(formula.GetProgram().Size(), 1);
+    int values[] = {5, 7};
+    EXPECT_EQ(formula.FormulaCalculator(values), 3);
+  }
+}
+
+// После свертки программа требует только оставшиеся переменные
+TEST(TFormulaTest, FormulaOptimizer_VariablesFoldedAway) {
+  {
+    TFormula<int> formula("x*0+3");
+    formula.FormulaConverter();
+    EXPECT_EQ(formula.GetProgram().GetVariables(), 1);
+    formula.FormulaOptimizer();
+    EXPECT_EQ(formula.GetProgram().GetVariables(), 0);
+    EXPECT_EQ(formula.FormulaCalculator(), 3);
+  }
+
+  {
+    TFormula<int> formula("x+y*0");
+    formula.FormulaConverter();
+    formula.FormulaOptimizer();
+    EXPECT_EQ(formula.GetProgram().GetVariables(), 1);
+    int x = 4;
+    EXPECT_EQ(formula.FormulaCalculator(&x), 4);
+  }
+
+  {
+    // Номер ячейки сохраняется, даже если младшие переменные исчезли
+    TFormula<int> formula("x*0+y");
+    formula.FormulaConverter();
+    formula.FormulaOptimizer();
+    EXPECT_EQ(formula.GetProgram().GetVariables(), 2);
+    EXPECT_THROW(formula.FormulaCalculator(), const char*);
+  }
+}
+
+// Упрощения, недопустимые для вещественных и для деления на ноль
+TEST(TFormulaTest, FormulaOptimizer_UnsafeIdentitiesKept) {
+  {
+    // x*0 для x = inf равно NaN, x+0 для x = -0.0 равно +0.0
+    TFormula<double> formula("x*0+y+0");
+    formula.FormulaConverter();
+    EXPECT_EQ(formula.FormulaOptimizer(), 0);
+    double values[] = {-0.0, -0.0};
+    EXPECT_FALSE(std::signbit(formula.FormulaCalculator(values)));
+  }
+
+  {
+    TFormula<int> formula("x+1/0");
+    formula.FormulaConverter();
+    EXPECT_EQ(formula.FormulaOptimizer(), 0);
+  }
+}
+
+// Оптимизация не меняет результат
+TEST(TFormulaTest, FormulaOptimizer_SameResult) {
+  const char* exprs[] = {"(a+2*3)*(b-4/2)+1*c", "a/1-(3-3)*b+c*(2+2)", "((1+2)*(3+4))/(a+b+c)"};
+  for (const char* e : exprs)
+  {
+    TFormula<double> plain(e), optimized(e);
+    plain.FormulaConverter();
+    optimized.FormulaConverter();
+    optimized.FormulaOptimizer();
+    EXPECT_LE(optimized.GetProgram().GetDepth(), plain.GetProgram().GetDepth());
+
+    double values[] = {1.5, -2.25, 4.0};
+    EXPECT_EQ(optimized.FormulaCalculator(values), plain.FormulaCalculator(values)) << e;
+  }
+}
+
+
+// Разбор чисел совпадает с istringstream побитово
+template<class T>
+static void ExpectSameAsStream(const std::string& token)
+{
+  T expected;
+  std::istringstream(token) >> expected;
+  T actual = ParseNumber<T>(token.data(), token.data() + token.size());
+  EXPECT_EQ(std::memcmp(&expected, &actual, sizeof(T)), 0) << token;
+}
+
+TEST(TFormulaTest, ParseNumber_BitIdentical) {
+  std::vector<std::string> tokens = {"0", "7", "42", "007", "1.5", "0.1", "3.14159265358979323846",
+                                     "1.2.3", ".", ".5", "5.", "2147483647", "2147483648",
+                                     "99999999999999999999", "16777217", "9007199254740993",
+                                     "0.30000000000000004", "123456789.987654321"};
+  tokens.push_back("1" + std::string(400, '0'));        // переполнение
+  tokens.push_back("0." + std::string(400, '0') + "1"); // исчезновение порядка
+
+  // Случайные последовательности цифр и точек
+  unsigned seed = 12345;
+  for (int i = 0; i < 2000; ++i)
+  {
+    std::string token;
+    int length = 1 + i % 24;
+    for (int j = 0; j < length; ++j)
+    {
+      seed = seed * 1103515245 + 12345;
+      unsigned r = (seed >> 16) % 23;
+      token += r < 20 ? char('0' + r % 10) : '.';
+    }
+    tokens.push_back(token);
+  }
+
+  for (const std::string& token : tokens)
+  {
+    ExpectSameAsStream<int>(token);
+    ExpectSameAsStream<long long>(token);
+    ExpectSameAsStream<float>(token);
+    ExpectSameAsStream<double>(token);
+  }
+}
+
+
+// Однопроходное вычисление совпадает с цепочкой Checker, Converter, Calculator
+TEST(TFormulaTest, Evaluate_MatchesThreePasses) {
+  const char* exprs[] = {"42", "1+2*3", "1-2+3", "((1+2)*(3-4))/2", "10/3", "1@+2#",
+                         "(1.25+2)*3-4/(8-6)", "((1+2)", "1+2)*3", "2*(3+4)-5/2*7+0.5"};
+  for (const char* e : exprs)
+  {
+    TFormula<double> formula(e);
+    formula.FormulaConverter();
+    EXPECT_EQ(TFormula<double>::Evaluate(e), formula.FormulaCalculator()) << e;
+  }
+
+  std::string longExpr = "1";
+  for (int i = 0; i < 10000; ++i)
+    longExpr += (i % 3) ? "+2*3" : "-(4-1)";
+  TFormula<long long> formula(longExpr);
+  formula.FormulaConverter();
+  EXPECT_EQ(TFormula<long long>::Evaluate(longExpr), formula.FormulaCalculator());
+}
+
+// Ошибки однопроходного вычисления
+TEST(TFormulaTest, Evaluate_Errors) {
+  EXPECT_THROW(TFormula<double>::Evaluate(""), const char*);
+  EXPECT_THROW(TFormula<double>::Evaluate("1+"), const char*);
+  EXPECT_THROW(TFormula<double>::Evaluate("x+1"), const char*);
+  EXPECT_THROW(TFormula<double>::Evaluate("$0*2"), const char*);
+}
@@ -0,0 +1,83 @@
+#include <gtest.h>
+#include <atomic>
+#include <string>
+#include <thread>
+#include <vector>
+#include "LockFreeStackClass.h"
+
+TEST(TLockFreeStackTest, Constructor)
+{
+    TLockFreeStack<int> stack(5);
+    EXPECT_EQ(stack.GetCapacity(), 5);
+    EXPECT_TRUE(stack.IsEmpty());
+    EXPECT_FALSE(stack.IsFull());
+
+    EXPECT_THROW(TLockFreeStack<int>(0), const char*);
+}
+
+TEST(TLockFreeStackTest, PushAndPop)
+{
+    TLockFreeStack<std::string> stack(3);
+    stack.push("a");
+    stack.push("b");
+    stack.push("c");
+    EXPECT_TRUE(stack.IsFull());
+    EXPECT_FALSE(stack.try_push("d"));
+    EXPECT_THROW(stack.push("d"), const char*);
+
+    EXPECT_EQ(stack.pop(), "c");
+    EXPECT_EQ(stack.pop(), "b");
+    stack.push("e"); // узел возвращается в пул и используется снова
+    EXPECT_EQ(stack.pop(), "e");
+    EXPECT_EQ(stack.pop(), "a");
+    EXPECT_TRUE(stack.IsEmpty());
+    EXPECT_THROW(stack.pop(), const char*);
+}
+
+// Потоки вперемешку кладут и снимают элементы:
+// каждый положенный элемент снимается ровно один раз
+TEST(TLockFreeStackTest, StressMixedPushPop)
+{
+    const int threadsCount = 6;
+    const int perThread = 40000;
+    TLockFreeStack<int> stack(64);
+
+    std::vector<std::atomic<int>> seen(threadsCount * perThread);
+    for (auto& s : seen)
+        s.store(0);
+    std::atomic<int> popped(0);
+
+    auto take = [&] {
+        int value;
+        if (!stack.try_pop(value))
+            return false;
+        seen[value].fetch_add(1);
+        popped.fetch_add(1);
+        return true;
+    };
+
+    std::vector<std::thread> threads;
+    for (int t = 0; t < threadsCount; ++t)
+    {
+        threads.emplace_back([&, t] {
+            for (int i = 0; i < perThread; ++i)
+            {
+                while (!stack.try_push(t * perThread + i))
+                    take(); // стек полон: освобождаем место
+                if (i % 2)
+                    take();
+            }
+        });
+    }
+    for (auto& thread : threads)
+        thread.join();
+    while (take()) {}
+
+    EXPECT_EQ(popped.load(), threadsCount * perThread);
+    int wrong = 0;
+    for (auto& s : seen)
+        wrong += s.load() != 1;
+    EXPECT_EQ(wrong, 0);
+    EXPECT_TRUE(stack.IsEmpty());
+    EXPECT_FALSE(stack.IsFull());
+}
@@ -0,0 +1,142 @@
+#include <gtest.h>
+#include <cmath>
+#include <limits>
+#include <vector>
+#include "MinKernel.h"
+#include "StackClass.h"
+#include "QueueClass.h"
+
+namespace
+{
+  template <class T>
+  T ScalarMin(T init, const std::vector<T>& data)
+  {
+    T acc = init;
+    for (T x : data)
+      if (x < acc)
+        acc = x;
+    return acc;
+  }
+
+  // Равенство с учетом знака нуля и NaN
+  template <class T>
+  bool SameValue(T a, T b)
+  {
+    if constexpr (std::is_floating_point_v<T>)
+    {
+      if (std::isnan(a) || std::isnan(b))
+        return std::isnan(a) && std::isnan(b);
+      return a == b && std::signbit(a) == std::signbit(b);
+    }
+    return a == b;
+  }
+
+  // Значения с частыми NaN и нулями обоих знаков
+  template <class T>
+  std::vector<T> Sample(size_t count, unsigned seed)
+  {
+    std::vector<T> data(count);
+    for (size_t i = 0; i < count; ++i)
+    {
+      seed = seed * 1103515245 + 12345;
+      unsigned r = seed >> 8;
+      if constexpr (std::is_floating_point_v<T>)
+      {
+        if (r % 13 == 0)
+          data[i] = std::numeric_limits<T>::quiet_NaN();
+        else if (r % 7 == 0)
+          data[i] = (r & 1) ? T(-0.0) : T(0.0);
+        else
+          data[i] = T((int)(r % 2001) - 500) / 4;
+      }
+      else
+        data[i] = (int)(r % 100001) - 500;
+    }
+    return data;
+  }
+
+  template <class T>
+  void CheckAllLevels()
+  {
+    const T nan = std::numeric_limits<T>::has_quiet_NaN ? std::numeric_limits<T>::quiet_NaN() : T(0);
+    T inits[] = {T(0), T(-0.0), T(1000), T(-1000), nan};
+    for (size_t count = 0; count < 150; count += 7)
+      for (unsigned seed = 1; seed < 6; ++seed)
+      {
+        std::vector<T> data = Sample<T>(count, seed);
+        for (T init : inits)
+        {
+          T expected = ScalarMin(init, data);
+          for (TMinKernelLevel level : {MinScalar, MinSse, MinAvx2})
+            ASSERT_TRUE(SameValue(MinKernel(init, data.data(), count, level), expected))
+                << "count " << count << ", seed " << seed << ", level " << level;
+          ASSERT_TRUE(SameValue(MinKernel(init, data.data(), count), expected));
+        }
+      }
+  }
+}
+
+TEST(MinKernelTest, IntMatchesScalarLoop)
+{
+  CheckAllLevels<int>();
+}
+
+TEST(MinKernelTest, FloatMatchesScalarLoop)
+{
+  CheckAllLevels<float>();
+}
+
+TEST(MinKernelTest, DoubleMatchesScalarLoop)
+{
+  CheckAllLevels<double>();
+}
+
+TEST(MinKernelTest, SignOfZeroIsFirstOccurrence)
+{
+  std::vector<double> data(100, 1.0);
+  data[40] = -0.0;
+  data[70] = 0.0;
+  double result = MinKernel(5.0, data.data(), data.size());
+  EXPECT_EQ(result, 0.0);
+  EXPECT_TRUE(std::signbit(result));
+}
+
+TEST(MinKernelTest, StackMinSkipsNaNAfterFirst)
+{
+  TStack<float> stack(200);
+  stack.push(3.0f);
+  for (int i = 0; i < 100; ++i)
+    stack.push(i % 3 ? std::numeric_limits<float>::quiet_NaN() : float(i + 10));
+  stack.push(-1.5f);
+  EXPECT_EQ(stack.Min(), -1.5f);
+
+  TStack<float> nanFirst(200);
+  nanFirst.push(std::numeric_limits<float>::quiet_NaN());
+  for (int i = 0; i < 100; ++i)
+    nanFirst.push(float(i));
+  EXPECT_TRUE(std::isnan(nanFirst.Min()));
+}
+
+TEST(MinKernelTest, QueueMinOverWrappedRing)
+{
+  TQueue<double> queue(101);
+  for (int i = 0; i < 80; ++i)
+    queue.push(i);
+  for (int i = 0; i < 60; ++i)
+    queue.pop();
+  // Второй отрезок начинается с NaN, меньший элемент за ним
+  queue.push(std::numeric_limits<double>::quiet_NaN());
+  for (int i = 0; i < 50; ++i)
+    queue.push(100 + i);
+  queue.push(-7.0);
+  EXPECT_EQ(queue.Min(), -7.0);
+
+  TQueue<int> ints(64);
+  for (int i = 0; i < 50; ++i)
+    ints.push(i);
+  for (int i = 0; i < 40; ++i)
+    ints.pop();
+  for (int i = 0; i < 45; ++i)
+    ints.push(30 - i);
+  EXPECT_EQ(ints.Min(), -14);
+}
@@ -0,0 +1,86 @@
+#include <gtest.h>
+#include <string>
+#include "MinQueueClass.h"
+
+TEST(TMinQueueTest, MinAfterPushAndPop)
+{
+    TMinQueue<int> queue;
+    queue.push(5);
+    EXPECT_EQ(queue.Min(), 5);
+    queue.push(3);
+    queue.push(8);
+    queue.push(4);
+    EXPECT_EQ(queue.Min(), 3);
+
+    EXPECT_EQ(queue.pop(), 5);
+    EXPECT_EQ(queue.Min(), 3);
+    EXPECT_EQ(queue.pop(), 3);
+    EXPECT_EQ(queue.Min(), 4);
+    EXPECT_EQ(queue.pop(), 8);
+    EXPECT_EQ(queue.Min(), 4);
+    EXPECT_EQ(queue.pop(), 4);
+    EXPECT_TRUE(queue.IsEmpty());
+    EXPECT_THROW(queue.Min(), const char*);
+    EXPECT_THROW(queue.pop(), const char*);
+}
+
+TEST(TMinQueueTest, EqualElements)
+{
+    TMinQueue<int> queue;
+    queue.push(2);
+    queue.push(2);
+    queue.push(3);
+    queue.pop();
+    EXPECT_EQ(queue.Min(), 2); // второй из равных еще в очереди
+    queue.pop();
+    EXPECT_EQ(queue.Min(), 3);
+}
+
+TEST(TMinQueueTest, SlidingWindowLikeLinearMin)
+{
+    // Сравнение со сканированием TQueue::Min при окне из 50 элементов
+    TMinQueue<int> window(4);
+    TQueue<int> plain(64);
+    unsigned seed = 99;
+    for (int i = 0; i < 3000; ++i)
+    {
+        seed = seed * 1103515245 + 12345;
+        int value = (int)((seed >> 8) % 200);
+        window.push(value);
+        plain.push(value);
+        if (window.Size() > 50)
+        {
+            window.pop();
+            plain.pop();
+        }
+        ASSERT_EQ(window.Min(), plain.Min());
+    }
+}
+
+TEST(TMinQueueTest, MaxQueue)
+{
+    TMaxQueue<double> queue;
+    queue.push(1.5);
+    queue.push(7.25);
+    queue.push(3.0);
+    EXPECT_DOUBLE_EQ(queue.Max(), 7.25);
+    queue.pop();
+    queue.pop();
+    EXPECT_DOUBLE_EQ(queue.Max(), 3.0);
+}
+
+TEST(TMinQueueTest, CustomComparator)
+{
+    // Самая короткая строка в окне
+    auto shorter = [](const std::string& a, const std::string& b) { return a.size() < b.size(); };
+    TMinQueue<std::string, decltype(shorter)> queue(4, shorter);
+    queue.push("banana");
+    queue.push("fig");
+    queue.push("kiwi");
+    queue.push("pea");
+    EXPECT_EQ(queue.Min(), "fig");
+    queue.pop();
+    queue.pop();
+    EXPECT_EQ(queue.Min(), "pea");
+    EXPECT_EQ(queue[0], "kiwi");
+}
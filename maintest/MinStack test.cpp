@@ -0,0 +1,175 @@
+#include <gtest.h>
+#include <cmath>
+#include <cstdint>
+#include <memory_resource>
+#include <new>
+#include <string>
+#include <type_traits>
+#include "MinStackClass.h"
+
+TEST(TMinStackTest, MinAfterPushAndPop)
+{
+    TMinStack<int> stack(5);
+    stack.push(10);
+    EXPECT_EQ(stack.Min(), 10);
+    stack.push(5);
+    EXPECT_EQ(stack.Min(), 5);
+    stack.push(1);
+    stack.push(8);
+    EXPECT_EQ(stack.Min(), 1);
+
+    EXPECT_EQ(stack.pop(), 8);
+    EXPECT_EQ(stack.Min(), 1);
+    EXPECT_EQ(stack.pop(), 1);
+    EXPECT_EQ(stack.Min(), 5);
+    EXPECT_EQ(stack.pop(), 5);
+    EXPECT_EQ(stack.Min(), 10);
+    stack.pop();
+    EXPECT_THROW(stack.Min(), const char*);
+}
+
+TEST(TMinStackTest, SameAsLinearMin)
+{
+    // Сравнение с TStack::Min на псевдослучайной последовательности, в том числе после роста
+    TMinStack<int> stack(2);
+    TStack<int> linear(2);
+    unsigned seed = 7;
+    for (int i = 0; i < 2000; ++i)
+    {
+        seed = seed * 1103515245 + 12345;
+        if (stack.IsEmpty() || (seed >> 16) % 3 != 0)
+        {
+            int value = (int)((seed >> 8) % 1000) - 500;
+            stack.push(value);
+            linear.push(value);
+        } else
+        {
+            EXPECT_EQ(stack.pop(), linear.pop());
+        }
+        if (!stack.IsEmpty())
+        {
+            ASSERT_EQ(stack.Min(), linear.Min());
+        }
+    }
+}
+
+TEST(TMinStackTest, NaNLikeLinearMin)
+{
+    TMinStack<double> stack;
+    stack.push(NAN);
+    stack.push(1.0);
+    EXPECT_TRUE(std::isnan(stack.Min()));
+
+    TMinStack<double> other;
+    other.push(2.0);
+    other.push(NAN);
+    other.push(1.0);
+    EXPECT_EQ(other.Min(), 1.0);
+}
+
+TEST(TMinStackTest, SetTopAndCapacity)
+{
+    TMinStack<int> stack(10);
+    stack.push(3);
+    stack.push(1);
+    stack.push(2);
+
+    stack.SetTop(1);
+    EXPECT_EQ(stack.Min(), 3);
+    stack.SetTop(3); // элементы снова видны, минимум пересчитан
+    EXPECT_EQ(stack.Min(), 1);
+
+    stack.SetCapacity(20);
+    EXPECT_EQ(stack.GetCapacity(), 20);
+    EXPECT_EQ(stack.Min(), 1);
+}
+
+TEST(TMinStackTest, CopyConstructor)
+{
+    TMinStack<std::string> stack1(3);
+    stack1.push("banana");
+    stack1.push("apple");
+
+    TMinStack<std::string> stack2(stack1);
+    stack1.pop();
+    EXPECT_EQ(stack1.Min(), "banana");
+    EXPECT_EQ(stack2.Min(), "apple");
+}
+
+TEST(TMinStackTest, EmplaceAndPopInto)
+{
+    TMinStack<std::string> stack(1);
+    stack.emplace(3, 'c');
+    stack.push(std::string("aa"));
+    stack.emplace("b");
+    EXPECT_EQ(stack.Min(), "aa");
+
+    std::string top;
+    stack.pop_into(top);
+    EXPECT_EQ(top, "b");
+    stack.pop_into(top);
+    EXPECT_EQ(top, "aa");
+    EXPECT_EQ(stack.Min(), "ccc");
+}
+
+TEST(TMinStackTest, ReferencesToTopAndMin)
+{
+    // Через указатель на TStack нельзя обойти обновление минимумов
+    static_assert(!std::is_convertible_v<TMinStack<int>*, TStack<int>*>);
+
+    TMinStack<std::string> stack;
+    stack.push("pear");
+    const std::string& top = stack.emplace("plum");
+    const std::string& min = stack.Min();
+    EXPECT_EQ(&min, &stack.Min()); // без копирования
+    EXPECT_EQ(&top, &stack.Peek());
+    EXPECT_EQ(stack.Peek(), "plum");
+    EXPECT_EQ(stack.Min(), "pear");
+}
+
+namespace
+{
+  // Отказывает в выделении памяти с номером fail (с нуля)
+  class TFailingResource : public std::pmr::memory_resource
+  {
+  public:
+    size_t allocations = 0;
+    size_t fail = SIZE_MAX;
+  protected:
+    void* do_allocate(size_t bytes, size_t alignment) override
+    {
+      if (allocations++ == fail)
+        throw std::bad_alloc();
+      return std::pmr::new_delete_resource()->allocate(bytes, alignment);
+    }
+    void do_deallocate(void* p, size_t bytes, size_t alignment) override
+    {
+      std::pmr::new_delete_resource()->deallocate(p, bytes, alignment);
+    }
+    bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override
+    {
+      return this == &other;
+    }
+  };
+}
+
+TEST(TMinStackTest, FailedMinPushRollsBack)
+{
+    TFailingResource resource;
+    TMinStack<int, std::pmr::polymorphic_allocator<int>> stack(2, &resource);
+    stack.push(5);
+    stack.push(3);
+
+    // Выделения: 0 и 1 - оба стека, 2 - рост основного, 3 - рост минимумов
+    resource.fail = 3;
+    EXPECT_THROW(stack.push(1), std::bad_alloc);
+    EXPECT_EQ(stack.Size(), 2);
+    EXPECT_EQ(stack.Peek(), 3);
+    EXPECT_EQ(stack.Min(), 3);
+
+    stack.push(1);
+    EXPECT_EQ(stack.Min(), 1);
+    EXPECT_EQ(stack.pop(), 1);
+    EXPECT_EQ(stack.pop(), 3);
+    EXPECT_EQ(stack.Min(), 5);
+}
@@ -0,0 +1,116 @@
+#include <gtest.h>
+#include <atomic>
+#include <thread>
+#include <vector>
+#include "MpmcQueueClass.h"
+
+TEST(TMpmcQueueTest, Constructor)
+{
+    TMpmcQueue<int> queue(5);
+    EXPECT_EQ(queue.GetCapacity(), 8); // округление до степени двойки
+    EXPECT_TRUE(queue.IsEmpty());
+    EXPECT_FALSE(queue.IsFull());
+    EXPECT_EQ(queue.Size(), 0);
+
+    EXPECT_THROW(TMpmcQueue<int>(1), const char*);
+    EXPECT_THROW(TMpmcQueue<int>(SIZE_MAX), const char*);
+    EXPECT_THROW(TMpmcQueue<int>((SIZE_MAX >> 1) + 2), const char*);
+}
+
+TEST(TMpmcQueueTest, PushAndPop)
+{
+    TMpmcQueue<int> queue(4);
+    queue.push(10);
+    queue.push(20);
+    queue.push(30);
+    EXPECT_EQ(queue.Size(), 3);
+
+    EXPECT_EQ(queue.pop(), 10);
+    EXPECT_EQ(queue.pop(), 20);
+    EXPECT_EQ(queue.pop(), 30);
+    EXPECT_TRUE(queue.IsEmpty());
+    EXPECT_THROW(queue.pop(), const char*);
+}
+
+TEST(TMpmcQueueTest, FullWithoutSpareSlot)
+{
+    TMpmcQueue<int> queue(4);
+    for (int i = 0; i < 4; ++i)
+        EXPECT_TRUE(queue.try_push(i));
+    EXPECT_TRUE(queue.IsFull());
+    EXPECT_FALSE(queue.try_push(4));
+    EXPECT_THROW(queue.push(4), const char*);
+
+    int value;
+    EXPECT_TRUE(queue.try_pop(value));
+    EXPECT_EQ(value, 0);
+    EXPECT_TRUE(queue.try_push(4));
+}
+
+TEST(TMpmcQueueTest, WrapAround)
+{
+    TMpmcQueue<int> queue(2);
+    int value;
+    for (int i = 0; i < 100; ++i)
+    {
+        EXPECT_TRUE(queue.try_push(i));
+        EXPECT_TRUE(queue.try_pop(value));
+        EXPECT_EQ(value, i);
+    }
+}
+
+// N производителей и M потребителей: ни один элемент не теряется и не повторяется
+TEST(TMpmcQueueTest, StressProducersConsumers)
+{
+    const int producers = 4, consumers = 3;
+    const int perProducer = 50000;
+    TMpmcQueue<int> queue(128);
+
+    std::vector<std::atomic<int>> seen(producers * perProducer);
+    for (auto& s : seen)
+        s.store(0);
+    std::atomic<int> consumed(0);
+    std::atomic<bool> ordered(true);
+
+    std::vector<std::thread> threads;
+    for (int p = 0; p < producers; ++p)
+    {
+        threads.emplace_back([&, p] {
+            for (int i = 0; i < perProducer; ++i)
+                while (!queue.try_push(p * perProducer + i))
+                    std::this_thread::yield();
+        });
+    }
+    for (int c = 0; c < consumers; ++c)
+    {
+        threads.emplace_back([&] {
+            // Элементы одного производителя приходят к потребителю по возрастанию
+            std::vector<int> last(producers, -1);
+            int value;
+            while (consumed.load() < producers * perProducer)
+            {
+                if (!queue.try_pop(value))
+                {
+                    std::this_thread::yield();
+                    continue;
+                }
+                consumed.fetch_add(1);
+                seen[value].fetch_add(1);
+                int p = value / perProducer;
+                if (value % perProducer <= last[p])
+                    ordered.store(false);
+                last[p] = value % perProducer;
+            }
+        });
+    }
+    for (auto& thread : threads)
+        thread.join();
+
+    EXPECT_EQ(consumed.load(), producers * perProducer);
+    EXPECT_TRUE(ordered.load());
+    int wrong = 0;
+    for (auto& s : seen)
+        wrong += s.load() != 1;
+    EXPECT_EQ(wrong, 0);
+    EXPECT_TRUE(queue.IsEmpty());
+}
@@ -1,6 +1,46 @@
 #include <gtest.h>
+#include <memory_resource>
+#include <string>
+#include <vector>
 #include "QueueClass.h"
 
+namespace
+{
+  // Считает живые экземпляры
+  struct TCounted
+  {
+    static int alive;
+    int value;
+    TCounted(int value_ = 0) : value(value_) { alive++; }
+    TCounted(const TCounted& other) : value(other.value) { alive++; }
+    TCounted& operator=(const TCounted& other) = default;
+    ~TCounted() { alive--; }
+  };
+  int TCounted::alive = 0;
+
+  // Копирование бросает, когда заканчивается запас budget;
+  // перемещение не noexcept, поэтому при переносе элементы копируются
+  struct TThrowing
+  {
+    static int alive;
+    static int budget;
+    int value;
+    TThrowing(int value_ = 0) : value(value_) { alive++; }
+    TThrowing(const TThrowing& other) : value(other.value)
+    {
+      if (budget == 0)
+        throw "Copy failed";
+      budget--;
+      alive++;
+    }
+    TThrowing(TThrowing&& other) : TThrowing(static_cast<const TThrowing&>(other)) {}
+    TThrowing& operator=(const TThrowing& other) = default;
+    ~TThrowing() { alive--; }
+  };
+  int TThrowing::alive = 0;
+  int TThrowing::budget = 0;
+}
+
 TEST(TQueueTest, DefaultConstructor)
 {
     TQueue<int> queue;
@@ -219,4 +259,346 @@ TEST(TQueueTest, DoubleType)
     EXPECT_DOUBLE_EQ(queue[0], 1.1);
     EXPECT_DOUBLE_EQ(queue[1], 2.2);
     EXPECT_DOUBLE_EQ(queue[2], 3.3);
-}
\ No newline at end of file
+}
+
+TEST(TQueueTest, SetCapacityUnwrapsRing)
+{
+    TQueue<int> queue(4);
+    queue.push(1);
+    queue.push(2);
+    queue.push(3);
+    queue.pop();
+    queue.pop();
+    queue.push(4);
+    queue.push(5); // элементы 3, 4, 5 переходят через конец буфера
+
+    queue.SetCapacity(8);
+    EXPECT_EQ(queue.GetStart(), 0);
+    EXPECT_EQ(queue.GetFinish(), 3);
+    EXPECT_EQ(queue.Size(), 3);
+    EXPECT_EQ(queue.pop(), 3);
+    EXPECT_EQ(queue.pop(), 4);
+    EXPECT_EQ(queue.pop(), 5);
+}
+
+TEST(TQueueTest, SetCapacityTooSmallThrows)
+{
+    TQueue<int> queue(5);
+    queue.push(1);
+    queue.push(2);
+    EXPECT_THROW(queue.SetCapacity(2), const char*);
+    EXPECT_NO_THROW(queue.SetCapacity(3));
+    EXPECT_TRUE(queue.IsFull());
+}
+
+TEST(TQueueTest, PushFullThrowsWithoutGrowth)
+{
+    TQueue<int> queue(2);
+    queue.push(1);
+    EXPECT_THROW(queue.push(2), const char*);
+
+    TQueue<int> empty;
+    EXPECT_TRUE(empty.IsFull());
+    EXPECT_THROW(empty.push(1), const char*);
+}
+
+TEST(TQueueTest, GrowableKeepsOrder)
+{
+    TQueue<int> queue(3, true);
+    EXPECT_TRUE(queue.IsGrowable());
+
+    // Чередование push и pop, чтобы рост происходил при перенесенном через конец кольце
+    int next = 0, expected = 0;
+    for (int round = 0; round < 200; ++round)
+    {
+        queue.push(next++);
+        queue.push(next++);
+        queue.push(next++);
+        EXPECT_EQ(queue.pop(), expected++);
+    }
+    EXPECT_EQ(queue.Size(), 400);
+    EXPECT_GE(queue.GetCapacity(), 401);
+    while (!queue.IsEmpty())
+        EXPECT_EQ(queue.pop(), expected++);
+    EXPECT_EQ(expected, next);
+}
+
+TEST(TQueueTest, GrowableFromEmpty)
+{
+    TQueue<std::string> queue;
+    queue.SetGrowable(true);
+    for (int i = 0; i < 50; ++i)
+        queue.push(std::to_string(i));
+    EXPECT_EQ(queue.Size(), 50);
+    for (int i = 0; i < 50; ++i)
+        EXPECT_EQ(queue[i], std::to_string(i));
+}
+
+
+TEST(TQueueTest, BulkPushPop)
+{
+    TQueue<int> queue(8);
+    int in[] = {1, 2, 3, 4, 5};
+    EXPECT_EQ(queue.push_bulk(in), 5);
+    EXPECT_EQ(queue.Size(), 5);
+
+    int out[3];
+    EXPECT_EQ(queue.pop_bulk(out), 3);
+    EXPECT_EQ(out[0], 1);
+    EXPECT_EQ(out[2], 3);
+
+    // Запись через конец буфера двумя отрезками
+    int more[] = {6, 7, 8, 9, 10};
+    EXPECT_EQ(queue.push_bulk(more), 5);
+    EXPECT_EQ(queue.Size(), 7);
+    EXPECT_TRUE(queue.IsFull());
+
+    int all[10];
+    EXPECT_EQ(queue.pop_bulk(all), 7);
+    for (int i = 0; i < 7; ++i)
+        EXPECT_EQ(all[i], i + 4);
+    EXPECT_TRUE(queue.IsEmpty());
+    EXPECT_EQ(queue.pop_bulk(all), 0);
+}
+
+TEST(TQueueTest, BulkPushPartial)
+{
+    TQueue<int> queue(4);
+    int in[] = {1, 2, 3, 4, 5};
+    EXPECT_EQ(queue.push_bulk(in), 3); // одна ячейка остается свободной
+    EXPECT_EQ(queue.FreeSpace(), 0);
+    EXPECT_EQ(queue.push_bulk(in), 0);
+
+    TQueue<int> empty;
+    EXPECT_EQ(empty.push_bulk(in), 0);
+}
+
+TEST(TQueueTest, BulkPushGrowable)
+{
+    TQueue<std::string> queue(4, true);
+    queue.push("a");
+    queue.push("b");
+    queue.pop();
+
+    std::vector<std::string> in;
+    for (int i = 0; i < 20; ++i)
+        in.push_back(std::to_string(i));
+    EXPECT_EQ(queue.push_bulk(in), 20);
+    EXPECT_EQ(queue.Size(), 21);
+
+    std::vector<std::string> out(21);
+    EXPECT_EQ(queue.pop_bulk(out), 21);
+    EXPECT_EQ(out[0], "b");
+    for (int i = 0; i < 20; ++i)
+        EXPECT_EQ(out[i + 1], std::to_string(i));
+}
+
+
+TEST(TQueueTest, ReserveWriteAndCommit)
+{
+    TQueue<int> queue(6);
+    queue.push(0);
+    queue.push(0);
+    queue.push(0);
+    queue.pop();
+    queue.pop();
+    queue.pop(); // start = finish = 3
+
+    // Запись на месте: два отрезка вокруг конца буфера
+    TQueue<int>::TRegion region = queue.ReserveWrite(4);
+    ASSERT_EQ(region.Size(), 4);
+    EXPECT_EQ(region.first.size(), 3);
+    EXPECT_EQ(region.second.size(), 1);
+    int value = 10;
+    for (int& slot : region.first)
+        slot = value++;
+    for (int& slot : region.second)
+        slot = value++;
+    EXPECT_TRUE(queue.IsEmpty()); // до подтверждения ничего не видно
+
+    queue.CommitWrite(4);
+    EXPECT_EQ(queue.Size(), 4);
+    for (int i = 0; i < 4; ++i)
+        EXPECT_EQ(queue[i], 10 + i);
+}
+
+TEST(TQueueTest, ReadRegionInPlace)
+{
+    TQueue<std::string> queue(4);
+    queue.push("a");
+    queue.push("b");
+    queue.push("c");
+    queue.pop();
+    queue.pop();
+    queue.push("d");
+    queue.push("e"); // c, d, e через конец буфера
+
+    TQueue<std::string>::TRegion region = queue.ReadRegion();
+    ASSERT_EQ(region.Size(), 3);
+    EXPECT_EQ(region.first[0], "c");
+    EXPECT_EQ(region.first[1], "d");
+    EXPECT_EQ(region.second[0], "e");
+    EXPECT_EQ(region.first.data(), queue.GetMemory() + 2); // без копирования
+
+    queue.CommitRead(2);
+    EXPECT_EQ(queue.Size(), 1);
+    EXPECT_EQ(queue.pop(), "e");
+    EXPECT_EQ(queue.ReadRegion().Size(), 0);
+}
+
+TEST(TQueueTest, CommitBeyondRegionThrows)
+{
+    TQueue<int> queue(4);
+    queue.push(1);
+    EXPECT_THROW(queue.CommitRead(2), const char*);
+
+    TQueue<int>::TRegion region = queue.ReserveWrite(10);
+    EXPECT_EQ(region.Size(), 2);
+    EXPECT_THROW(queue.CommitWrite(3), const char*);
+    queue.CommitWrite(1);
+    EXPECT_EQ(queue.Size(), 2);
+    EXPECT_THROW(queue.CommitWrite(1), const char*); // резерв уже подтвержден
+}
+
+TEST(TQueueTest, ReserveWriteGrowable)
+{
+    TQueue<int> queue(2, true);
+    TQueue<int>::TRegion region = queue.ReserveWrite(100);
+    EXPECT_EQ(region.Size(), 100);
+    EXPECT_GE(queue.GetCapacity(), 101);
+    for (size_t i = 0; i < region.first.size(); ++i)
+        region.first[i] = i;
+    queue.CommitWrite(100);
+    EXPECT_EQ(queue[99], 99);
+}
+
+TEST(TQueueTest, MutatorsThrowWhileWriteReserved)
+{
+    TQueue<std::string> queue(8);
+    queue.push("a");
+    TQueue<std::string>::TRegion region = queue.ReserveWrite(3);
+    region.first[0] = "b";
+    // Выданные ячейки нельзя занять в обход CommitWrite
+    EXPECT_THROW(queue.push("x"), const char*);
+    std::string bulk[2] = {"y", "z"};
+    EXPECT_THROW(queue.push_bulk(bulk), const char*);
+    EXPECT_THROW(queue.SetCapacity(16), const char*);
+    EXPECT_EQ(queue.Size(), 1);
+
+    queue.CommitWrite(1);
+    EXPECT_EQ(queue.Size(), 2);
+    queue.push("c");
+    EXPECT_EQ(queue.pop(), "a");
+    EXPECT_EQ(queue.pop(), "b");
+    EXPECT_EQ(queue.pop(), "c");
+}
+
+TEST(TQueueTest, PopWhileWriteReserved)
+{
+    TQueue<std::string> queue(8);
+    queue.push("a");
+    queue.push("b");
+    queue.push("c");
+    TQueue<std::string>::TRegion region = queue.ReserveWrite(2);
+    region.first[0] = "d";
+    region.first[1] = "e";
+
+    // Голова не пересекается с выданными ячейками
+    EXPECT_EQ(queue.pop(), "a");
+    std::string out[1];
+    EXPECT_EQ(queue.pop_bulk(out), 1);
+    EXPECT_EQ(out[0], "b");
+
+    queue.CommitWrite(2);
+    EXPECT_EQ(queue.Size(), 3);
+    EXPECT_EQ(queue.pop(), "c");
+    EXPECT_EQ(queue.pop(), "d");
+    EXPECT_EQ(queue.pop(), "e");
+}
+
+TEST(TQueueTest, ElementsConstructedOnlyOnPush)
+{
+    {
+        TQueue<TCounted> queue(8, true);
+        EXPECT_EQ(TCounted::alive, 0);
+        for (int i = 0; i < 6; ++i)
+            queue.push(TCounted(i));
+        for (int i = 0; i < 4; ++i)
+            queue.pop();
+        for (int i = 6; i < 30; ++i)
+            queue.push(TCounted(i)); // через конец буфера и с ростом
+        EXPECT_EQ(TCounted::alive, (int)queue.Size());
+
+        TCounted out[5];
+        queue.pop_bulk(std::span<TCounted>(out, 5));
+        EXPECT_EQ(out[0].value, 4);
+        EXPECT_EQ(TCounted::alive, (int)queue.Size() + 5);
+
+        TQueue<TCounted>::TRegion region = queue.ReserveWrite(3);
+        EXPECT_EQ(TCounted::alive, (int)queue.Size() + 5 + 3);
+        region.first[0] = TCounted(100);
+        queue.CommitWrite(1); // две лишние ячейки разрушены
+        EXPECT_EQ(TCounted::alive, (int)queue.Size() + 5);
+
+        queue.CommitRead(2);
+        EXPECT_EQ(TCounted::alive, (int)queue.Size() + 5);
+        queue.SetFinish((queue.GetFinish() + queue.GetCapacity() - 3) % queue.GetCapacity());
+        EXPECT_EQ(TCounted::alive, (int)queue.Size() + 5);
+        queue.SetStart((queue.GetStart() + queue.GetCapacity() - 2) % queue.GetCapacity());
+        EXPECT_EQ(TCounted::alive, (int)queue.Size() + 5);
+        queue.ReserveWrite(2); // не подтверждена, разрушается деструктором
+    }
+    EXPECT_EQ(TCounted::alive, 0);
+}
+
+TEST(TQueueTest, PmrArena)
+{
+    char buffer[8192];
+    std::pmr::monotonic_buffer_resource arena(buffer, sizeof(buffer), std::pmr::null_memory_resource());
+    TPmrQueue<std::pmr::string> queue(2, true, &arena);
+    for (int i = 0; i < 20; ++i)
+    {
+        std::string text = "element number " + std::to_string(i) + " with a long tail";
+        queue.push(std::pmr::string(text.c_str()));
+    }
+    EXPECT_EQ(queue.GetAllocator().resource(), &arena);
+    EXPECT_GE((char*)queue.GetMemory(), buffer);
+    EXPECT_LT((char*)queue.GetMemory(), buffer + sizeof(buffer));
+    // Элементы построены с ресурсом очереди
+    EXPECT_EQ(queue.ReadRegion().first[0].get_allocator().resource(), &arena);
+    EXPECT_EQ(queue.pop(), "element number 0 with a long tail");
+}
+
+TEST(TQueueTest, RelocationRollsBackOnException)
+{
+    {
+        TQueue<TThrowing> queue(4);
+        TThrowing::budget = 100;
+        for (int i = 0; i < 3; ++i)
+            queue.push(TThrowing(i));
+        queue.pop();
+        queue.push(TThrowing(3)); // элементы по обе стороны конца буфера
+
+        // Перенос второго элемента бросает
+        TThrowing::budget = 1;
+        EXPECT_THROW(queue.SetCapacity(8), const char*);
+        EXPECT_EQ(queue.GetCapacity(), 4);
+        EXPECT_EQ(queue.Size(), 3);
+        EXPECT_EQ(TThrowing::alive, 3);
+
+        // Рост при push: копия нового элемента строится, перенос бросает
+        queue.SetGrowable(true);
+        TThrowing::budget = 1;
+        const TThrowing four(4);
+        EXPECT_THROW(queue.push(four), const char*);
+        EXPECT_EQ(queue.GetCapacity(), 4);
+        EXPECT_EQ(TThrowing::alive, 4);
+
+        TThrowing::budget = 100;
+        queue.push(four);
+        EXPECT_EQ(queue.GetCapacity(), 8);
+        for (int i = 1; i <= 4; ++i)
+            EXPECT_EQ(queue.pop().value, i);
+    }
+    EXPECT_EQ(TThrowing::alive, 0);
+}
@@ -0,0 +1,85 @@
+#include <gtest.h>
+#include <string>
+#include "RingQueueClass.h"
+
+TEST(TRingQueueTest, CapacityRoundedToPowerOfTwo)
+{
+    TRingQueue<int> queue(5);
+    EXPECT_EQ(queue.GetCapacity(), 8);
+    EXPECT_TRUE(queue.IsEmpty());
+    EXPECT_EQ(queue.Size(), 0);
+
+    TRingQueue<int> exact(16);
+    EXPECT_EQ(exact.GetCapacity(), 16);
+    EXPECT_THROW(TRingQueue<int>(0), const char*);
+    EXPECT_THROW(TRingQueue<int>(SIZE_MAX), const char*);
+    EXPECT_THROW(TRingQueue<int>((SIZE_MAX >> 1) + 2), const char*);
+}
+
+TEST(TRingQueueTest, AllSlotsUsable)
+{
+    // В отличие от TQueue, свободная ячейка не нужна
+    TRingQueue<int> queue(4);
+    for (int i = 0; i < 4; ++i)
+        queue.push(i);
+    EXPECT_TRUE(queue.IsFull());
+    EXPECT_EQ(queue.Size(), 4);
+    EXPECT_THROW(queue.push(4), const char*);
+
+    for (int i = 0; i < 4; ++i)
+        EXPECT_EQ(queue.pop(), i);
+    EXPECT_TRUE(queue.IsEmpty());
+    EXPECT_THROW(queue.pop(), const char*);
+}
+
+TEST(TRingQueueTest, WrapAround)
+{
+    TRingQueue<int> queue(4);
+    int expected = 0;
+    for (int i = 0; i < 1000; ++i)
+    {
+        queue.push(i);
+        if (queue.Size() == 3)
+        {
+            EXPECT_EQ(queue.pop(), expected++);
+        }
+    }
+    EXPECT_EQ(queue.Size(), 2);
+    EXPECT_EQ(queue[0], 998);
+    EXPECT_EQ(queue[1], 999);
+    EXPECT_THROW(queue[2], const char*);
+}
+
+TEST(TRingQueueTest, IteratorAndMin)
+{
+    TRingQueue<int> queue(4);
+    queue.push(9);
+    queue.push(9);
+    queue.pop();
+    queue.pop();
+    queue.push(5);
+    queue.push(3);
+    queue.push(7); // через конец буфера
+
+    int sum = 0;
+    for (auto& item : queue)
+        sum += item;
+    EXPECT_EQ(sum, 15);
+    EXPECT_EQ(queue.Min(), 3);
+}
+
+TEST(TRingQueueTest, CopyAndMove)
+{
+    TRingQueue<std::string> queue(2);
+    queue.push("hello");
+    queue.push("world");
+
+    TRingQueue<std::string> copy(queue);
+    EXPECT_EQ(copy.pop(), "hello");
+    EXPECT_EQ(queue.Size(), 2);
+
+    TRingQueue<std::string> moved(std::move(queue));
+    EXPECT_EQ(moved.Size(), 2);
+    EXPECT_EQ(moved[1], "world");
+    EXPECT_EQ(queue.GetCapacity(), 0);
+}
@@ -0,0 +1,143 @@
+#include <gtest.h>
+#include <memory_resource>
+#include <string>
+#include "SmallStackClass.h"
+#include "FormulaClass.h"
+
+namespace
+{
+  // Считает выделения памяти переданного контейнеру ресурса
+  class TCountingResource : public std::pmr::memory_resource
+  {
+  public:
+    size_t allocations = 0;
+  protected:
+    void* do_allocate(size_t bytes, size_t alignment) override
+    {
+      allocations++;
+      return std::pmr::new_delete_resource()->allocate(bytes, alignment);
+    }
+    void do_deallocate(void* p, size_t bytes, size_t alignment) override
+    {
+      std::pmr::new_delete_resource()->deallocate(p, bytes, alignment);
+    }
+    bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override
+    {
+      return this == &other;
+    }
+  };
+
+  // Копирование бросает, когда заканчивается запас budget;
+  // перемещение не noexcept, поэтому при переносе элементы копируются
+  struct TThrowing
+  {
+    static int alive;
+    static int budget;
+    int value;
+    TThrowing(int value_) : value(value_) { alive++; }
+    TThrowing(const TThrowing& other) : value(other.value)
+    {
+      if (budget == 0)
+        throw "Copy failed";
+      budget--;
+      alive++;
+    }
+    TThrowing(TThrowing&& other) : TThrowing(static_cast<const TThrowing&>(other)) {}
+    ~TThrowing() { alive--; }
+  };
+  int TThrowing::alive = 0;
+  int TThrowing::budget = 0;
+}
+
+TEST(TSmallStackTest, InlineUntilCapacity)
+{
+    TCountingResource resource;
+    TSmallStack<int, 4, std::pmr::polymorphic_allocator<int>> stack(&resource);
+    for (int i = 0; i < 4; ++i)
+        stack.push(i);
+    EXPECT_TRUE(stack.IsInline());
+    EXPECT_EQ(resource.allocations, 0);
+
+    stack.push(4); // переход в кучу
+    EXPECT_FALSE(stack.IsInline());
+    EXPECT_EQ(stack.GetCapacity(), 8);
+    EXPECT_EQ(resource.allocations, 1);
+    for (int i = 4; i >= 0; --i)
+        EXPECT_EQ(stack.pop(), i);
+    EXPECT_TRUE(stack.IsEmpty());
+    EXPECT_THROW(stack.pop(), const char*);
+    EXPECT_THROW(stack.Peek(), const char*);
+}
+
+TEST(TSmallStackTest, CopyAndMove)
+{
+    TSmallStack<std::string, 2> small;
+    small.emplace("one");
+    small.push(std::string("two"));
+    TSmallStack<std::string, 2> big(small);
+    big.push("three");
+
+    TSmallStack<std::string, 2> movedSmall(std::move(small));
+    EXPECT_TRUE(movedSmall.IsInline());
+    EXPECT_EQ(movedSmall.Peek(), "two");
+    EXPECT_TRUE(small.IsEmpty());
+
+    TSmallStack<std::string, 2> movedBig(std::move(big));
+    EXPECT_FALSE(movedBig.IsInline());
+    EXPECT_EQ(movedBig.Size(), 3);
+    EXPECT_TRUE(big.IsInline());
+    EXPECT_TRUE(big.IsEmpty());
+    big.push("reused");
+    EXPECT_EQ(big[0], "reused");
+
+    std::string top;
+    movedBig.pop_into(top);
+    EXPECT_EQ(top, "three");
+    EXPECT_EQ(movedBig[1], "two");
+}
+
+TEST(TSmallStackTest, SpillRollsBackOnException)
+{
+    TCountingResource resource;
+    {
+        TSmallStack<TThrowing, 2, std::pmr::polymorphic_allocator<TThrowing>> stack(&resource);
+        stack.emplace(1);
+        stack.emplace(2);
+
+        // Новый элемент строится, перенос первого бросает
+        TThrowing::budget = 1;
+        EXPECT_THROW(stack.push(TThrowing(3)), const char*);
+        EXPECT_TRUE(stack.IsInline());
+        EXPECT_EQ(stack.Size(), 2);
+        EXPECT_EQ(TThrowing::alive, 2);
+        EXPECT_EQ(resource.allocations, 1);
+
+        TThrowing::budget = 100;
+        stack.push(TThrowing(3));
+        EXPECT_FALSE(stack.IsInline());
+        EXPECT_EQ(stack.pop().value, 3);
+        EXPECT_EQ(stack.pop().value, 2);
+        EXPECT_EQ(stack.pop().value, 1);
+    }
+    EXPECT_EQ(TThrowing::alive, 0);
+}
+
+// Стеки разбора на TSmallStack: результаты всех путей вычисления совпадают.
+// Отсутствие выделений в самих стеках проверяет InlineUntilCapacity
+TEST(TSmallStackTest, FormulaPipeline)
+{
+    TFormula<double> formula("(1.5+2)*(3-4/(2+6))-x", {"x"});
+    int brackets[20];
+    EXPECT_EQ(formula.FormulaChecker(brackets, 20), 0);
+    formula.FormulaConverter();
+    double values[] = {0.5};
+    EXPECT_DOUBLE_EQ(formula.FormulaCalculator(values), 8.25);
+    EXPECT_DOUBLE_EQ(TFormula<double>::Evaluate("(1.5+2)*(3-4/(2+6))-0.5"), 8.25);
+
+    // Вложенность глубже встроенной емкости стеков
+    std::string deep = std::string(40, '(') + "1" + std::string(40, ')') + "*2";
+    TFormula<double> nested(deep);
+    nested.FormulaConverter();
+    EXPECT_DOUBLE_EQ(nested.FormulaCalculator(), 2.0);
+    EXPECT_DOUBLE_EQ(TFormula<double>::Evaluate(deep), 2.0);
+}
@@ -0,0 +1,86 @@
+#include <gtest.h>
+#include <thread>
+#include "SpscQueueClass.h"
+
+TEST(TSpscQueueTest, Constructor)
+{
+    TSpscQueue<int> queue(5);
+    EXPECT_EQ(queue.GetCapacity(), 5);
+    EXPECT_TRUE(queue.IsEmpty());
+    EXPECT_FALSE(queue.IsFull());
+    EXPECT_EQ(queue.Size(), 0);
+
+    EXPECT_THROW(TSpscQueue<int>(1), const char*);
+}
+
+TEST(TSpscQueueTest, PushAndPop)
+{
+    TSpscQueue<int> queue(5);
+    queue.push(10);
+    queue.push(20);
+    queue.push(30);
+    EXPECT_EQ(queue.Size(), 3);
+
+    EXPECT_EQ(queue.pop(), 10);
+    EXPECT_EQ(queue.pop(), 20);
+    EXPECT_EQ(queue.pop(), 30);
+    EXPECT_TRUE(queue.IsEmpty());
+    EXPECT_THROW(queue.pop(), const char*);
+}
+
+TEST(TSpscQueueTest, FullLikeTQueue)
+{
+    // Как и в TQueue, одна ячейка остается свободной
+    TSpscQueue<int> queue(3);
+    EXPECT_TRUE(queue.try_push(1));
+    EXPECT_TRUE(queue.try_push(2));
+    EXPECT_TRUE(queue.IsFull());
+    EXPECT_FALSE(queue.try_push(3));
+    EXPECT_THROW(queue.push(3), const char*);
+}
+
+TEST(TSpscQueueTest, WrapAround)
+{
+    TSpscQueue<int> queue(4);
+    int value;
+    for (int i = 0; i < 100; ++i)
+    {
+        EXPECT_TRUE(queue.try_push(i));
+        EXPECT_TRUE(queue.try_push(i + 1000));
+        EXPECT_EQ(queue.Size(), 2);
+        EXPECT_TRUE(queue.try_pop(value));
+        EXPECT_EQ(value, i);
+        EXPECT_TRUE(queue.try_pop(value));
+        EXPECT_EQ(value, i + 1000);
+    }
+    EXPECT_FALSE(queue.try_pop(value));
+}
+
+TEST(TSpscQueueTest, ProducerConsumerThreads)
+{
+    TSpscQueue<long long> queue(64);
+    const long long count = 200000;
+
+    std::thread producer([&] {
+        for (long long i = 0; i < count; ++i)
+            while (!queue.try_push(i))
+                std::this_thread::yield();
+    });
+
+    // Элементы приходят все и по порядку
+    long long expected = 0, value;
+    bool ordered = true;
+    while (expected < count)
+    {
+        if (queue.try_pop(value))
+        {
+            ordered = ordered && value == expected;
+            expected++;
+        } else
+            std::this_thread::yield();
+    }
+    producer.join();
+
+    EXPECT_TRUE(ordered);
+    EXPECT_TRUE(queue.IsEmpty());
+}
@@ -1,6 +1,57 @@
 #include <gtest.h>
+#include <memory>
+#include <memory_resource>
+#include <string>
 #include "StackClass.h"
 
+namespace
+{
+  // Считает живые экземпляры
+  struct TCounted
+  {
+    static int alive;
+    int value;
+    TCounted(int value_ = 0) : value(value_) { alive++; }
+    TCounted(const TCounted& other) : value(other.value) { alive++; }
+    ~TCounted() { alive--; }
+  };
+  int TCounted::alive = 0;
+
+  // Считает копирования
+  struct TCopyCounted
+  {
+    static int copies;
+    std::string text;
+    TCopyCounted(std::string text_ = "") : text(std::move(text_)) {}
+    TCopyCounted(const TCopyCounted& other) : text(other.text) { copies++; }
+    TCopyCounted(TCopyCounted&& other) noexcept = default;
+    TCopyCounted& operator=(const TCopyCounted& other) { text = other.text; copies++; return *this; }
+    TCopyCounted& operator=(TCopyCounted&& other) noexcept = default;
+  };
+  int TCopyCounted::copies = 0;
+
+  // Копирование бросает, когда заканчивается запас budget;
+  // перемещение не noexcept, поэтому при росте элементы копируются
+  struct TThrowing
+  {
+    static int alive;
+    static int budget;
+    int value;
+    TThrowing(int value_) : value(value_) { alive++; }
+    TThrowing(const TThrowing& other) : value(other.value)
+    {
+      if (budget == 0)
+        throw "Copy failed";
+      budget--;
+      alive++;
+    }
+    TThrowing(TThrowing&& other) : TThrowing(static_cast<const TThrowing&>(other)) {}
+    ~TThrowing() { alive--; }
+  };
+  int TThrowing::alive = 0;
+  int TThrowing::budget = 0;
+}
+
 TEST(TStackTest, DefaultConstructor)
 {
     TStack<int> stack;
@@ -288,4 +339,105 @@ TEST(TStackTest, MinMethod_WithCopyConstructor)
   stack1.pop();
   EXPECT_EQ(stack1.Min(), 2);   // В stack1 теперь [5, 2]
   EXPECT_EQ(stack2.Min(), 2);   // В stack2 остается [5, 2, 8]
-}
\ No newline at end of file
+}
+
+TEST(TStackTest, ElementsConstructedOnlyOnPush)
+{
+    {
+        TStack<TCounted> stack(100);
+        EXPECT_EQ(TCounted::alive, 0); // емкость не строит элементы
+        for (int i = 0; i < 250; ++i)
+            stack.push(TCounted(i)); // с ростом
+        EXPECT_EQ(TCounted::alive, 250);
+        EXPECT_EQ(stack.pop().value, 249);
+        EXPECT_EQ(TCounted::alive, 249);
+        stack.SetTop(10);
+        EXPECT_EQ(TCounted::alive, 10);
+        TStack<TCounted> copy(stack);
+        EXPECT_EQ(TCounted::alive, 20);
+    }
+    EXPECT_EQ(TCounted::alive, 0);
+}
+
+TEST(TStackTest, PmrArena)
+{
+    char buffer[4096];
+    std::pmr::monotonic_buffer_resource arena(buffer, sizeof(buffer), std::pmr::null_memory_resource());
+    TPmrStack<int> stack(4, &arena);
+    for (int i = 0; i < 100; ++i)
+        stack.push(i);
+    EXPECT_EQ(stack.GetAllocator().resource(), &arena);
+    EXPECT_GE((char*)stack.GetMemory(), buffer);
+    EXPECT_LT((char*)stack.GetMemory(), buffer + sizeof(buffer));
+    EXPECT_EQ(stack.Peek(), 99);
+
+    // Строки-элементы получают память той же арены
+    TPmrStack<std::pmr::string> strings(2, &arena);
+    strings.push("a string long enough to leave the small buffer");
+    EXPECT_EQ(strings.begin().operator*().get_allocator().resource(), &arena);
+}
+
+TEST(TStackTest, MoveOnlyElements)
+{
+    TStack<std::unique_ptr<int>> stack(2);
+    stack.push(std::make_unique<int>(1));
+    stack.emplace(new int(2));
+    stack.push(std::make_unique<int>(3)); // рост с перемещением
+    EXPECT_EQ(stack.GetCapacity(), 4);
+
+    std::unique_ptr<int> top;
+    stack.pop_into(top);
+    EXPECT_EQ(*top, 3);
+    EXPECT_EQ(*stack.pop(), 2);
+    EXPECT_EQ(stack.Size(), 1);
+    stack.pop();
+    EXPECT_THROW(stack.pop_into(top), const char*);
+}
+
+TEST(TStackTest, MovePushAndGrowthDoNotCopy)
+{
+    TCopyCounted::copies = 0;
+    TStack<TCopyCounted> stack(1);
+    for (int i = 0; i < 100; ++i)
+        stack.push(TCopyCounted(std::to_string(i)));
+    stack.emplace("emplaced");
+    TCopyCounted out;
+    stack.pop_into(out);
+    EXPECT_EQ(out.text, "emplaced");
+    stack.pop_into(out);
+    EXPECT_EQ(out.text, "99");
+    EXPECT_EQ(TCopyCounted::copies, 0);
+
+    stack.push(out); // lvalue копируется
+    EXPECT_EQ(TCopyCounted::copies, 1);
+}
+
+TEST(TStackTest, GrowthRollsBackOnException)
+{
+    {
+        TStack<TThrowing> stack(2);
+        stack.emplace(1);
+        stack.emplace(2);
+
+        // Новый элемент строится, перенос первого бросает
+        TThrowing::budget = 1;
+        EXPECT_THROW(stack.push(TThrowing(3)), const char*);
+        // Бросает построение нового элемента
+        TThrowing::budget = 0;
+        const TThrowing four(4);
+        EXPECT_THROW(stack.push(four), const char*);
+        EXPECT_THROW(stack.SetCapacity(8), const char*);
+
+        EXPECT_EQ(stack.GetCapacity(), 2);
+        EXPECT_EQ(stack.Size(), 2);
+        EXPECT_EQ(TThrowing::alive, 3);
+
+        TThrowing::budget = 100;
+        stack.push(four);
+        EXPECT_EQ(stack.GetCapacity(), 4);
+        EXPECT_EQ(stack.pop().value, 4);
+        EXPECT_EQ(stack.pop().value, 2);
+        EXPECT_EQ(stack.pop().value, 1);
+    }
+    EXPECT_EQ(TThrowing::alive, 0);
+}
@@ -0,0 +1,155 @@
+#include <gtest.h>
+#include <cmath>
+#include <string>
+#include <vector>
+#include "FormulaClass.h"
+
+// Тест построения дерева по формуле
+TEST(TExprTreeTest, BuildFromFormula)
+{
+  TFormula<double> formula("(a+2)*b");
+  formula.FormulaConverter();
+  const TExprTree<double>& tree = formula.BuildTree();
+
+  ASSERT_EQ(tree.Size(), 5);
+  const TNode<double>& root = tree[tree.GetRoot()];
+  EXPECT_EQ(root.code, OpMul);
+  EXPECT_EQ(tree[root.left].code, OpAdd);
+  EXPECT_EQ(tree[root.right].code, OpVar);
+  EXPECT_EQ(tree[root.right].slot, 1);
+  EXPECT_EQ(tree.Height(), 3);
+
+  double values[] = {1.5, 4.0};
+  EXPECT_DOUBLE_EQ(tree.Evaluate(values), formula.FormulaCalculator(values));
+}
+
+// Дерево переводится обратно в ту же программу
+TEST(TExprTreeTest, ToProgramRoundTrip)
+{
+  TFormula<int> formula("a*(b-3)/(c+a*2)-7");
+  formula.FormulaConverter();
+  const TProgram<int>& program = formula.GetProgram();
+
+  TProgram<int> rebuilt;
+  formula.BuildTree().ToProgram(rebuilt);
+  ASSERT_EQ(rebuilt.Size(), program.Size());
+  for (size_t i = 0; i < program.Size(); ++i)
+  {
+    EXPECT_EQ(rebuilt[i].code, program[i].code);
+    EXPECT_EQ(rebuilt[i].slot, program[i].slot);
+    EXPECT_EQ(rebuilt[i].value, program[i].value);
+  }
+  EXPECT_EQ(rebuilt.GetDepth(), program.GetDepth());
+}
+
+// Общее поддерево хранится один раз
+TEST(TExprTreeTest, SharedSubexpression)
+{
+  TExprTree<double> tree;
+  unsigned x = tree.AddVariable(0);
+  unsigned sum = tree.AddOperator(OpAdd, x, tree.AddConst(1.0));
+  unsigned square = tree.AddOperator(OpMul, sum, sum);
+  EXPECT_EQ(tree.Size(), 4);
+  EXPECT_FALSE(tree.HasRoot()); // добавление узла не меняет корень
+  EXPECT_THROW(tree.Evaluate(), const char*);
+  tree.SetRoot(square);
+  EXPECT_EQ(tree.GetRoot(), square);
+
+  double value = 2.0;
+  EXPECT_DOUBLE_EQ(tree.Evaluate(&value), 9.0);
+
+  // В программе общее поддерево пришлось бы повторить
+  TProgram<double> program;
+  EXPECT_THROW(tree.ToProgram(program), const char*);
+
+  EXPECT_THROW(tree.AddOperator(OpAdd, 0, 10), const char*);
+  EXPECT_THROW(tree.AddOperator(OpConst, 0, 1), const char*);
+}
+
+// Узлы вне дерева корня не вычисляются
+TEST(TExprTreeTest, UnreachableNodesIgnored)
+{
+  TExprTree<int> tree;
+  unsigned two = tree.AddConst(2);
+  unsigned three = tree.AddConst(3);
+  unsigned product = tree.AddOperator(OpMul, two, three);
+  // Мертвые узлы после корня: деление на ноль и несвязанная переменная
+  unsigned zero = tree.AddConst(0);
+  unsigned dead = tree.AddOperator(OpDiv, two, zero);
+  tree.AddOperator(OpAdd, dead, tree.AddVariable(0));
+  tree.SetRoot(product);
+  EXPECT_EQ(tree.Height(), 2);
+  EXPECT_EQ(tree.Evaluate(), 6);
+
+  // Мертвые узлы перед корнем
+  unsigned root = tree.AddOperator(OpSub, product, tree.AddConst(2));
+  tree.SetRoot(root);
+  EXPECT_EQ(tree.Height(), 3);
+  EXPECT_EQ(tree.Evaluate(), 4);
+
+  TProgram<int> program;
+  tree.ToProgram(program);
+  EXPECT_EQ(program.Size(), 5);
+  EXPECT_EQ(program.Run(), 4);
+}
+
+// Глубокая цепочка общих поддеревьев: вычисление линейно по числу узлов
+TEST(TExprTreeTest, SharedChain)
+{
+  TExprTree<double> tree;
+  unsigned node = tree.AddVariable(0);
+  for (int i = 0; i < 200; ++i)
+    node = tree.AddOperator(OpAdd, node, node); // 2^200 листьев в развернутом виде
+  tree.SetRoot(node);
+  EXPECT_EQ(tree.Height(), 201);
+
+  double value = 1.0;
+  EXPECT_DOUBLE_EQ(tree.Evaluate(&value), std::ldexp(1.0, 200));
+  EXPECT_THROW(tree.Evaluate(), const char*);
+
+  // Буфер выделяется при первом вызове и дальше переиспользуется
+  std::vector<double> scratch;
+  EXPECT_DOUBLE_EQ(tree.Evaluate(&value, scratch), std::ldexp(1.0, 200));
+  const double* buffer = scratch.data();
+  value = 0.5;
+  EXPECT_DOUBLE_EQ(tree.Evaluate(&value, scratch), std::ldexp(1.0, 199));
+  EXPECT_EQ(scratch.data(), buffer);
+
+  TProgram<double> program;
+  EXPECT_THROW(tree.ToProgram(program), const char*);
+}
+
+// Большое дерево строится и обходится без рекурсии
+TEST(TExprTreeTest, LargeTree)
+{
+  // 100000 узлов в глубину: 1-(1-(1-...))
+  std::string expr;
+  for (int i = 0; i < 50000; ++i)
+    expr += "1-(";
+  expr += "0";
+  expr += std::string(50000, ')');
+
+  TFormula<long long> formula(expr);
+  formula.FormulaConverter();
+  const TExprTree<long long>& tree = formula.BuildTree();
+  EXPECT_EQ(tree.Size(), 100001);
+  EXPECT_EQ(tree.Height(), 50001);
+  EXPECT_EQ(tree.Evaluate(), 0);
+
+  TProgram<long long> program;
+  tree.ToProgram(program);
+  EXPECT_EQ(program.Size(), 100001);
+  EXPECT_EQ(program.Run(), formula.FormulaCalculator());
+}
+
+// Пустое дерево
+TEST(TExprTreeTest, EmptyTree)
+{
+  TExprTree<int> tree;
+  EXPECT_TRUE(tree.IsEmpty());
+  EXPECT_EQ(tree.Height(), 0);
+  EXPECT_THROW(tree.Evaluate(), const char*);
+
+  TProgram<int> invalid;
+  EXPECT_THROW(tree.Build(invalid), const char*);
+}
@@ -0,0 +1,173 @@
+#include <gtest.h>
+#include <atomic>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+#include "WorkStealingDequeClass.h"
+#include "SchedulerClass.h"
+
+TEST(TWorkStealingDequeTest, OwnerIsLifoThiefIsFifo)
+{
+    TWorkStealingDeque<int> deque(4);
+    EXPECT_EQ(deque.GetCapacity(), 4);
+    EXPECT_TRUE(deque.IsEmpty());
+    for (int i = 0; i < 4; ++i)
+        deque.push(i);
+    EXPECT_EQ(deque.Size(), 4);
+
+    int value;
+    EXPECT_TRUE(deque.try_steal(value));
+    EXPECT_EQ(value, 0);
+    EXPECT_TRUE(deque.try_pop(value));
+    EXPECT_EQ(value, 3);
+    EXPECT_TRUE(deque.try_pop(value));
+    EXPECT_EQ(value, 2);
+    EXPECT_TRUE(deque.try_steal(value));
+    EXPECT_EQ(value, 1);
+    EXPECT_FALSE(deque.try_pop(value));
+    EXPECT_FALSE(deque.try_steal(value));
+    EXPECT_TRUE(deque.IsEmpty());
+
+    EXPECT_THROW(TWorkStealingDeque<int>(0), const char*);
+    EXPECT_THROW(TWorkStealingDeque<int>(SIZE_MAX), const char*);
+    EXPECT_THROW(TWorkStealingDeque<int>((SIZE_MAX >> 1) + 2), const char*);
+    EXPECT_EQ(TWorkStealingDeque<int>(5).GetCapacity(), 8);
+}
+
+TEST(TWorkStealingDequeTest, GrowsOnDemand)
+{
+    TWorkStealingDeque<int> deque(2);
+    int value;
+    // Сдвигаем счетчики, чтобы элементы переходили через конец кольца
+    for (int i = 0; i < 3; ++i)
+    {
+        deque.push(i);
+        deque.try_steal(value);
+    }
+    for (int i = 0; i < 100; ++i)
+        deque.push(i);
+    EXPECT_EQ(deque.GetCapacity(), 128);
+    for (int i = 0; i < 50; ++i)
+    {
+        EXPECT_TRUE(deque.try_steal(value));
+        EXPECT_EQ(value, i);
+    }
+    for (int i = 99; i >= 50; --i)
+    {
+        EXPECT_TRUE(deque.try_pop(value));
+        EXPECT_EQ(value, i);
+    }
+}
+
+// Владелец кладет и снимает, перехватчики забирают: каждый элемент ровно один раз
+TEST(TWorkStealingDequeTest, StressOwnerAndThieves)
+{
+    const int total = 200000;
+    const int thieves = 3;
+    TWorkStealingDeque<int> deque(8);
+    std::vector<std::atomic<int>> seen(total);
+    for (auto& s : seen)
+        s.store(0);
+    std::atomic<int> taken(0);
+    std::atomic<bool> done(false);
+
+    std::vector<std::thread> threads;
+    for (int t = 0; t < thieves; ++t)
+    {
+        threads.emplace_back([&] {
+            int value;
+            while (!done.load() || !deque.IsEmpty())
+            {
+                if (deque.try_steal(value))
+                {
+                    seen[value].fetch_add(1);
+                    taken.fetch_add(1);
+                } else
+                    std::this_thread::yield();
+            }
+        });
+    }
+    int value;
+    int clobbered = 0; // неудачный try_pop изменил value
+    for (int i = 0; i < total; ++i)
+    {
+        deque.push(i);
+        if (i % 3 != 0)
+            continue;
+        value = -1;
+        if (deque.try_pop(value))
+        {
+            seen[value].fetch_add(1);
+            taken.fetch_add(1);
+        } else
+            clobbered += value != -1;
+    }
+    while (deque.try_pop(value))
+    {
+        seen[value].fetch_add(1);
+        taken.fetch_add(1);
+    }
+    done.store(true);
+    for (auto& thread : threads)
+        thread.join();
+
+    EXPECT_EQ(taken.load(), total);
+    EXPECT_EQ(clobbered, 0);
+    int wrong = 0;
+    for (auto& s : seen)
+        wrong += s.load() != 1;
+    EXPECT_EQ(wrong, 0);
+}
+
+TEST(TSchedulerTest, ParallelForVisitsEveryIndexOnce)
+{
+    TScheduler scheduler(4);
+    EXPECT_EQ(scheduler.GetThreads(), 4);
+    const size_t count = 100003;
+    std::vector<std::atomic<int>> visits(count);
+    for (auto& v : visits)
+        v.store(0);
+
+    // Несколько заданий подряд на одном пуле
+    for (size_t grain : {1, 7, 1000})
+        scheduler.ParallelFor(count, grain, [&](size_t i) { visits[i].fetch_add(1); });
+    scheduler.ParallelFor(0, 1, [&](size_t i) { visits[i].fetch_add(1); });
+
+    int wrong = 0;
+    for (auto& v : visits)
+        wrong += v.load() != 3;
+    EXPECT_EQ(wrong, 0);
+}
+
+TEST(TSchedulerTest, SingleThread)
+{
+    TScheduler scheduler(1);
+    std::vector<int> out(1000, 0);
+    scheduler.ParallelFor(out.size(), 16, [&](size_t i) { out[i] = (int)i * 2; });
+    for (size_t i = 0; i < out.size(); ++i)
+        ASSERT_EQ(out[i], (int)i * 2);
+}
+
+TEST(TSchedulerTest, ExceptionReachesCaller)
+{
+    TScheduler scheduler(4);
+    // Бросают несколько потоков; вызывающий получает одно исключение
+    EXPECT_THROW(scheduler.ParallelFor(10000, 8, [](size_t i) {
+        if (i % 1000 == 999)
+            throw std::runtime_error("body failed");
+    }), std::runtime_error);
+    EXPECT_THROW(scheduler.ParallelFor(100, 1, [](size_t i) {
+        if (i == 0)
+            throw "body failed";
+    }), const char*);
+
+    // Пул пригоден для следующего задания, старых кусков не осталось
+    std::vector<std::atomic<int>> visits(5000);
+    for (auto& v : visits)
+        v.store(0);
+    scheduler.ParallelFor(visits.size(), 4, [&](size_t i) { visits[i].fetch_add(1); });
+    int wrong = 0;
+    for (auto& v : visits)
+        wrong += v.load() != 1;
+    EXPECT_EQ(wrong, 0);
+}